@@ -18,12 +18,19 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #pragma once
 // Set the mouse settings to a comfortable speed/accuracy trade-off,
 // assuming a screen refresh rate of 60 Htz or higher
-// The default is 50. This makes the mouse ~3 times faster and more accurate
+// Inertia mode: the cursor has a velocity that accelerates while a direction is
+// held and decays with friction once it's released, in integer maths. A report
+// is sent every MOUSEKEY_INTERVAL, one per frame at 60Hz.
+#define MOUSEKEY_INERTIA
 #define MOUSEKEY_INTERVAL 16
-// The default is 20. Since we made the mouse about 3 times faster with the previous setting,
-// give it more time to accelerate to max speed to retain precise control over short distances.
+// Frames to reach full speed (~0.65s, the default is 32). A slower build-up
+// than the default keeps precise control over short distances.
 #define MOUSEKEY_TIME_TO_MAX 40
-// The default is 300. Let's try and make this as low as possible while keeping the cursor responsive
+// Pixels per frame at full speed (the default is 32)
+#define MOUSEKEY_MAX_SPEED 28
+// How quickly the cursor coasts to a stop, out of 255 (the default is 24)
+#define MOUSEKEY_FRICTION 24
+// The default is 150 with inertia. Let's try and make this as low as possible while keeping the cursor responsive
 #define MOUSEKEY_DELAY 100
 // It makes sense to use the same delay for the mouseweel
 #define MOUSEKEY_WHEEL_DELAY 100
@@ -32,6 +39,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 // The default is 40
 #define MOUSEKEY_WHEEL_TIME_TO_MAX 100
 
+// Debounce time in ms (see DEBOUNCE_TYPE in rules.mk). With eager presses this
+// only delays releases, and stops a key re-triggering for this long after a press
+#define DEBOUNCE 5
+
 // Pick good defaults for enabling homerow modifiers
 #define TAPPING_TERM 200
 #define PERMISSIVE_HOLD  // Use release order to determine tap vs hold
@@ -39,13 +50,49 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 // Chordal Hold: homerow mods only activate for opposite-hand chords
 #define CHORDAL_HOLD
+// Flow Tap: a homerow mod-tap pressed within this many ms of the previous key
+// is tapped immediately, so fast typing isn't held back until the key is released
+#define FLOW_TAP_TERM 150
 // #define HOLD_ON_OTHER_KEY_PRESS  // Conflicts with PERMISSIVE_HOLD
 
+// Adaptive tapping term (see tapping_term.c): each mod-tap learns its own term,
+// saved in the EEPROM user datablock. The four keys' statistics take 50 bytes
+// on AVR and 58 on ARM, where the structs are padded. 64 fits both, and fixes
+// the offset of the usage totals saved after them (usage.c), which would be
+// lost if it moved.
+#ifdef ADAPTIVE_TAPPING_TERM_ENABLE
+#    define TAPPING_TERM_PER_KEY
+#    define ADAPTIVE_TAPPING_DATA_SIZE 64
+#else
+#    define ADAPTIVE_TAPPING_DATA_SIZE 0
+#endif
+
+// Key usage totals (see usage.c), saved after the learned tapping terms
+#ifdef USAGE_STATS_ENABLE
+#    define USAGE_STATS_DATA_SIZE 512
+#else
+#    define USAGE_STATS_DATA_SIZE 0
+#endif
+
+#if ADAPTIVE_TAPPING_DATA_SIZE + USAGE_STATS_DATA_SIZE > 0
+#    define EECONFIG_USER_DATA_SIZE (ADAPTIVE_TAPPING_DATA_SIZE + USAGE_STATS_DATA_SIZE)
+#endif
+
+// Combos: per-combo terms and layers, see combo_rules[] in keymap.c
+#define COMBO_TERM_PER_COMBO
+#define COMBO_SHOULD_TRIGGER
+
 // https://docs.qmk.fm/#/feature_caps_word
 #define DOUBLE_TAP_SHIFT_TURNS_ON_CAPS_WORD
 
 // Underglow configuration
 #ifdef RGBLIGHT_ENABLE
+// Breathing reads a precomputed table instead of calculating exp(sin()) in
+// floating point every frame
+#    define RGBLIGHT_EFFECT_BREATHE_TABLE
+// Animations pause while typing, and resume once no key has been pressed for
+// this long (see pause_underglow() in keymap.c)
+#    define RGBLIGHT_TYPING_PAUSE_MS 1000
 #    define RGBLIGHT_EFFECT_BREATHING
 #    define RGBLIGHT_EFFECT_RAINBOW_MOOD
 #    define RGBLIGHT_EFFECT_RAINBOW_SWIRL
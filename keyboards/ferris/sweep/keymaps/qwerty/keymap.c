@@ -1,256 +1,225 @@
 #include QMK_KEYBOARD_H
-
-// Aliases for characters that don't have a keycode
-#define KC_DOUBLE_QUOTE_OPEN LALT(KC_LEFT_BRACKET)
-#define KC_DOUBLE_QUOTE_CLOSE LALT(LSFT(KC_LEFT_BRACKET))
-#define KC_SINGLE_QUOTE_OPEN LALT(KC_RIGHT_BRACKET)
-#define KC_SINGLE_QUOTE_CLOSE LALT(LSFT(KC_RIGHT_BRACKET))
-#define KC_UK_HASH LALT(KC_3)
-#define KC_UK_POUND LSFT(KC_3)
-#define KC_EURO LALT(KC_2)
-
-#define KC_NAV_HISTORY_BACK LGUI(KC_LEFT_BRACKET)
-#define KC_NAV_HISTORY_FORWARD LGUI(KC_RIGHT_BRACKET)
-#define KC_NAV_PREV_TAB LCTL(LSFT(KC_TAB))
-#define KC_NAV_NEXT_TAB RCTL(KC_TAB)
-
-const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
-	[0] = LAYOUT_split_3x5_2(
-        KC_Q, KC_W, KC_E, KC_R, KC_T,
-        KC_Y, KC_U, KC_I, KC_O, KC_P,
-
-        KC_A, KC_S, MT(MOD_LGUI,KC_D), MT(MOD_LCTL,KC_F), KC_G,
-        KC_H, MT(MOD_RCTL,KC_J), MT(MOD_RGUI,KC_K), KC_L, KC_SCLN,
-
-        KC_Z, KC_X, KC_C, KC_V, KC_B,
-        KC_N, KC_M, QK_REPEAT_KEY, KC_DOT, KC_SLSH,
-
-        TO(1), OSM(MOD_LSFT),
-        OSM(MOD_LALT), KC_SPACE
-    ),
-    // QWERTY numbers and navigation
-	[1] = LAYOUT_split_3x5_2(
-        KC_ESC, KC_KP_7, KC_KP_8, KC_KP_9, KC_NO,
-        KC_NAV_HISTORY_BACK, KC_NAV_PREV_TAB, KC_NAV_NEXT_TAB, KC_NAV_HISTORY_FORWARD, KC_BSPC,
-
-        KC_TAB, KC_KP_4, MT(MOD_LGUI,KC_KP_5), MT(MOD_LCTL,KC_KP_6), KC_NO,
-        KC_LEFT, MT(MOD_RCTL,KC_DOWN), MT(MOD_RGUI,KC_UP), KC_RIGHT, KC_ENTER,
-
-        KC_KP_0, KC_KP_1, KC_KP_2, KC_KP_3, KC_NO,
-        KC_NO, KC_NO, QK_REPEAT_KEY, KC_DOT, KC_NO,
-
-        TO(2), KC_TRNS,
-        KC_TRNS, TO(0)
-    ),
-    // QWERTY alt-symbols layer (macOS Alt+key symbols - rare)
-    [2] = LAYOUT_split_3x5_2(
-        LALT(KC_Q), LALT(KC_W), LALT(KC_E), LALT(KC_R), LALT(KC_T),
-        LALT(KC_Y), LALT(KC_U), LALT(KC_I), LALT(KC_O), LALT(KC_P),
-
-        LALT(KC_A), LALT(KC_S), LALT(KC_D), LALT(KC_F), LALT(KC_G),
-        LALT(KC_H), LALT(KC_J), LALT(KC_K), LALT(KC_L), LALT(KC_SCLN),
-
-        LALT(KC_Z), LALT(KC_X), LALT(KC_C), LALT(KC_V), LALT(KC_B),
-        LALT(KC_N), LALT(KC_M), LALT(KC_COMMA), LALT(KC_DOT), LALT(KC_SLSH),
-
-        TO(0), KC_TRNS,
-        KC_TRNS, TO(0)
-    )
-};
+#include "latency.h"
+#include "tapping_term.h"
+#include "keytrace.h"
+#include "usage.h"
 
 // https://docs.qmk.fm/#/feature_key_overrides?id=creating-key-overrides
-// All layers are QWERTY layers (0, 1, 2)
+// All layers are QWERTY layers (BASE, NAV, SYMBOL)
 #define QWERTY_LAYERS ~0
 
-// QWERTY: alt ; = enter, shift+alt ; = shift+enter
-const key_override_t semicolon_key_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_ALT, KC_SCLN, KC_ENTER, QWERTY_LAYERS, MOD_MASK_SHIFT);
-const key_override_t semicolon_key_alt_shifted_override = ko_make_with_layers(MOD_MASK_SA, KC_SCLN, LSFT(KC_ENTER), QWERTY_LAYERS);
-
-// QWERTY: alt p = backspace, shift+alt p = noop
-const key_override_t p_key_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_ALT, KC_P, KC_BSPC, QWERTY_LAYERS, MOD_MASK_SHIFT);
-const key_override_t p_key_alt_shifted_override = ko_make_with_layers(MOD_MASK_SA, KC_P, KC_NO, QWERTY_LAYERS);
-
-// QWERTY: alt / = delete word, shift+alt / = noop
-const key_override_t slsh_key_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_ALT, KC_SLSH, LALT(KC_BSPC), QWERTY_LAYERS, MOD_MASK_SHIFT);
-const key_override_t slsh_key_alt_shifted_override = ko_make_with_layers(MOD_MASK_SA, KC_SLSH, KC_NO, QWERTY_LAYERS);
-
 // Alt+key on QWERTY layer 0 outputs symbols (from old layer 1)
 // These overrides don't trigger when Ctrl, Shift, or Command is held, allowing Cmd+Alt+key shortcuts to pass through to macOS
-// Top row
-const key_override_t q_key_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_ALT, KC_Q, KC_ESC, QWERTY_LAYERS, MOD_MASK_CSG);
-const key_override_t w_key_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_ALT, KC_W, KC_AT, QWERTY_LAYERS, MOD_MASK_CSG);
-const key_override_t e_key_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_ALT, KC_E, KC_UK_HASH, QWERTY_LAYERS, MOD_MASK_CSG);
-const key_override_t r_key_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_ALT, KC_R, KC_DOLLAR, QWERTY_LAYERS, MOD_MASK_CSG);
-const key_override_t t_key_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_ALT, KC_T, KC_PERCENT, QWERTY_LAYERS, MOD_MASK_CSG);
-const key_override_t y_key_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_ALT, KC_Y, KC_CIRCUMFLEX, QWERTY_LAYERS, MOD_MASK_CSG);
-const key_override_t u_key_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_ALT, KC_U, KC_AMPERSAND, QWERTY_LAYERS, MOD_MASK_CSG);
-const key_override_t i_key_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_ALT, KC_I, KC_ASTERISK, QWERTY_LAYERS, MOD_MASK_CSG);
-const key_override_t o_key_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_ALT, KC_O, KC_MINUS, QWERTY_LAYERS, MOD_MASK_CSG);
-
-// Middle row
-const key_override_t a_key_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_ALT, KC_A, KC_TAB, QWERTY_LAYERS, MOD_MASK_CSG);
-const key_override_t s_key_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_ALT, KC_S, KC_GRAVE, QWERTY_LAYERS, MOD_MASK_CSG);
-// D, F, J, K handled in process_record_user() due to mod-tap interference
-const key_override_t g_key_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_ALT, KC_G, KC_NO, QWERTY_LAYERS, MOD_MASK_CSG);
-const key_override_t h_key_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_ALT, KC_H, KC_BACKSLASH, QWERTY_LAYERS, MOD_MASK_CSG);
-const key_override_t l_key_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_ALT, KC_L, KC_RBRC, QWERTY_LAYERS, MOD_MASK_CSG);
-
-// Bottom row
-const key_override_t z_key_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_ALT, KC_Z, KC_TILDE, QWERTY_LAYERS, MOD_MASK_CSG);
-const key_override_t x_key_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_ALT, KC_X, KC_MINUS, QWERTY_LAYERS, MOD_MASK_CSG);
-const key_override_t c_key_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_ALT, KC_C, KC_PLUS, QWERTY_LAYERS, MOD_MASK_CSG);
-const key_override_t v_key_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_ALT, KC_V, KC_EQUAL, QWERTY_LAYERS, MOD_MASK_CSG);
-const key_override_t b_key_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_ALT, KC_B, KC_UNDERSCORE, QWERTY_LAYERS, MOD_MASK_CSG);
-const key_override_t m_key_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_ALT, KC_M, KC_LPRN, QWERTY_LAYERS, MOD_MASK_CSG);
-const key_override_t dot_key_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_ALT, KC_DOT, KC_RPRN, QWERTY_LAYERS, MOD_MASK_CSG);
-
+#define ALT_SYMBOL(key, symbol) ko_make_with_layers_and_negmods(MOD_MASK_ALT, key, symbol, QWERTY_LAYERS, MOD_MASK_CSG)
 // Shift+Alt+key on QWERTY layer 0 (shifted symbols from old layer 1)
 // These overrides don't trigger when Command is held, allowing Cmd+Shift+Alt+key shortcuts to pass through to macOS
-// Top row
-const key_override_t q_key_shift_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_SA, KC_Q, KC_NO, QWERTY_LAYERS, MOD_MASK_GUI);
-const key_override_t w_key_shift_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_SA, KC_W, KC_EURO, QWERTY_LAYERS, MOD_MASK_GUI);
-const key_override_t e_key_shift_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_SA, KC_E, KC_NO, QWERTY_LAYERS, MOD_MASK_GUI);
-const key_override_t r_key_shift_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_SA, KC_R, KC_UK_POUND, QWERTY_LAYERS, MOD_MASK_GUI);
-const key_override_t t_key_shift_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_SA, KC_T, KC_NO, QWERTY_LAYERS, MOD_MASK_GUI);
-const key_override_t y_key_shift_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_SA, KC_Y, KC_NO, QWERTY_LAYERS, MOD_MASK_GUI);
-const key_override_t u_key_shift_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_SA, KC_U, KC_NO, QWERTY_LAYERS, MOD_MASK_GUI);
-const key_override_t i_key_shift_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_SA, KC_I, KC_NO, QWERTY_LAYERS, MOD_MASK_GUI);
-const key_override_t o_key_shift_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_SA, KC_O, KC_NO, QWERTY_LAYERS, MOD_MASK_GUI);
-const key_override_t p_key_shift_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_SA, KC_P, KC_NO, QWERTY_LAYERS, MOD_MASK_GUI);
-
-// Middle row
-const key_override_t a_key_shift_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_SA, KC_A, LSFT(KC_TAB), QWERTY_LAYERS, MOD_MASK_GUI);
-const key_override_t s_key_shift_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_SA, KC_S, KC_NO, QWERTY_LAYERS, MOD_MASK_GUI);
-// D, F, J, K handled in process_record_user() due to mod-tap interference
-const key_override_t g_key_shift_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_SA, KC_G, KC_NO, QWERTY_LAYERS, MOD_MASK_GUI);
-const key_override_t h_key_shift_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_SA, KC_H, KC_NO, QWERTY_LAYERS, MOD_MASK_GUI);
-const key_override_t l_key_shift_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_SA, KC_L, KC_RCBR, QWERTY_LAYERS, MOD_MASK_GUI);
-const key_override_t scln_key_shift_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_SA, KC_SCLN, KC_NO, QWERTY_LAYERS, MOD_MASK_GUI);
-
-// Bottom row
-const key_override_t z_key_shift_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_SA, KC_Z, KC_NO, QWERTY_LAYERS, MOD_MASK_GUI);
-const key_override_t x_key_shift_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_SA, KC_X, KC_DOUBLE_QUOTE_OPEN, QWERTY_LAYERS, MOD_MASK_GUI);
-const key_override_t c_key_shift_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_SA, KC_C, KC_SINGLE_QUOTE_OPEN, QWERTY_LAYERS, MOD_MASK_GUI);
-const key_override_t v_key_shift_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_SA, KC_V, KC_SINGLE_QUOTE_CLOSE, QWERTY_LAYERS, MOD_MASK_GUI);
-const key_override_t b_key_shift_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_SA, KC_B, KC_DOUBLE_QUOTE_CLOSE, QWERTY_LAYERS, MOD_MASK_GUI);
-const key_override_t n_key_shift_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_SA, KC_N, KC_NO, QWERTY_LAYERS, MOD_MASK_GUI);
-const key_override_t m_key_shift_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_SA, KC_M, KC_LABK, QWERTY_LAYERS, MOD_MASK_GUI);
-const key_override_t comma_key_shift_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_SA, KC_COMMA, KC_NO, QWERTY_LAYERS, MOD_MASK_GUI);
-const key_override_t dot_key_shift_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_SA, KC_DOT, KC_RABK, QWERTY_LAYERS, MOD_MASK_GUI);
-const key_override_t slsh_key_shift_alt_override = ko_make_with_layers_and_negmods(MOD_MASK_SA, KC_SLSH, KC_NO, QWERTY_LAYERS, MOD_MASK_GUI);
-
-const key_override_t delete_key_override = ko_make_basic(MOD_MASK_SHIFT, KC_BSPC, KC_DEL);
-const key_override_t period_key_override = ko_make_basic(MOD_MASK_SHIFT, KC_DOT, KC_COMM);
-const key_override_t repeat_key_override = ko_make_basic(MOD_MASK_SHIFT, QK_REPEAT_KEY, QK_ALT_REPEAT_KEY);
-const key_override_t lparen_key_override = ko_make_basic(MOD_MASK_SHIFT, KC_LPRN, KC_LABK);
-const key_override_t rparen_key_override = ko_make_basic(MOD_MASK_SHIFT, KC_RPRN, KC_RABK);
-const key_override_t minus_key_override = ko_make_basic(MOD_MASK_SHIFT, KC_MINUS, KC_DOUBLE_QUOTE_OPEN);
-const key_override_t plus_key_override = ko_make_basic(MOD_MASK_SHIFT, KC_PLUS, KC_SINGLE_QUOTE_OPEN);
-const key_override_t equal_key_override = ko_make_basic(MOD_MASK_SHIFT, KC_EQUAL, KC_SINGLE_QUOTE_CLOSE);
-const key_override_t underscore_key_override = ko_make_basic(MOD_MASK_SHIFT, KC_UNDERSCORE, KC_DOUBLE_QUOTE_CLOSE);
-const key_override_t dollar_key_override = ko_make_basic(MOD_MASK_SHIFT, KC_DOLLAR, KC_UK_POUND);
-const key_override_t at_key_override = ko_make_basic(MOD_MASK_SHIFT, KC_AT, KC_EURO);
+#define SHIFT_ALT_SYMBOL(key, symbol) ko_make_with_layers_and_negmods(MOD_MASK_SA, key, symbol, QWERTY_LAYERS, MOD_MASK_GUI)
+// Editing keys (Enter, Backspace, delete word) still work with Ctrl or Command held
+#define ALT_EDIT(key, output) ko_make_with_layers_and_negmods(MOD_MASK_ALT, key, output, QWERTY_LAYERS, MOD_MASK_SHIFT)
+#define SHIFT_ALT_EDIT(key, output) ko_make_with_layers(MOD_MASK_SA, key, output, QWERTY_LAYERS)
+#define SHIFTED(key, output) ko_make_basic(MOD_MASK_SHIFT, key, output)
 // Alt+keypad number keys act as FN keys
-const key_override_t kp_one_key_override = ko_make_basic(MOD_MASK_ALT, KC_KP_1, KC_F1);
-const key_override_t kp_two_key_override = ko_make_basic(MOD_MASK_ALT, KC_KP_2, KC_F2);
-const key_override_t kp_three_key_override = ko_make_basic(MOD_MASK_ALT, KC_KP_3, KC_F3);
-const key_override_t kp_four_key_override = ko_make_basic(MOD_MASK_ALT, KC_KP_4, KC_F4);
-const key_override_t kp_five_key_override = ko_make_basic(MOD_MASK_ALT, KC_KP_5, KC_F5);
-const key_override_t kp_six_key_override = ko_make_basic(MOD_MASK_ALT, KC_KP_6, KC_F6);
-const key_override_t kp_seven_key_override = ko_make_basic(MOD_MASK_ALT, KC_KP_7, KC_F7);
-const key_override_t kp_eight_key_override = ko_make_basic(MOD_MASK_ALT, KC_KP_8, KC_F8);
-const key_override_t kp_nine_key_override = ko_make_basic(MOD_MASK_ALT, KC_KP_9, KC_F9);
-const key_override_t kp_zero_key_override = ko_make_basic(MOD_MASK_ALT, KC_KP_0, KC_F10);
-
-// This globally defines all key overrides to be used
-const key_override_t *key_overrides[] = {
-    &semicolon_key_alt_override,
-    &semicolon_key_alt_shifted_override,
-    &p_key_alt_override,
-    &p_key_alt_shifted_override,
-    &slsh_key_alt_override,
-    &slsh_key_alt_shifted_override,
-    // QWERTY Alt+key overrides
-    &q_key_alt_override,
-    &w_key_alt_override,
-    &e_key_alt_override,
-    &r_key_alt_override,
-    &t_key_alt_override,
-    &y_key_alt_override,
-    &u_key_alt_override,
-    &i_key_alt_override,
-    &o_key_alt_override,
-    &a_key_alt_override,
-    &s_key_alt_override,
-    // D, F, J, K handled in process_record_user()
-    &g_key_alt_override,
-    &h_key_alt_override,
-    &l_key_alt_override,
-    &z_key_alt_override,
-    &x_key_alt_override,
-    &c_key_alt_override,
-    &v_key_alt_override,
-    &b_key_alt_override,
-    &m_key_alt_override,
-    &dot_key_alt_override,
-    // QWERTY Shift+Alt vacant overrides
-    &q_key_shift_alt_override,
-    &w_key_shift_alt_override,
-    &e_key_shift_alt_override,
-    &r_key_shift_alt_override,
-    &t_key_shift_alt_override,
-    &y_key_shift_alt_override,
-    &u_key_shift_alt_override,
-    &i_key_shift_alt_override,
-    &o_key_shift_alt_override,
-    &p_key_shift_alt_override,
-    &a_key_shift_alt_override,
-    &s_key_shift_alt_override,
-    // D, F, J, K handled in process_record_user()
-    &g_key_shift_alt_override,
-    &h_key_shift_alt_override,
-    &l_key_shift_alt_override,
-    &scln_key_shift_alt_override,
-    &z_key_shift_alt_override,
-    &x_key_shift_alt_override,
-    &c_key_shift_alt_override,
-    &v_key_shift_alt_override,
-    &b_key_shift_alt_override,
-    &n_key_shift_alt_override,
-    &m_key_shift_alt_override,
-    &comma_key_shift_alt_override,
-    &dot_key_shift_alt_override,
-    &slsh_key_shift_alt_override,
-    &delete_key_override,
-    &period_key_override,
-    &repeat_key_override,
-    &lparen_key_override,
-    &rparen_key_override,
-    &minus_key_override,
-    &plus_key_override,
-    &equal_key_override,
-    &underscore_key_override,
-    &dollar_key_override,
-    &at_key_override,
-    &kp_one_key_override,
-    &kp_two_key_override,
-    &kp_three_key_override,
-    &kp_four_key_override,
-    &kp_five_key_override,
-    &kp_six_key_override,
-    &kp_seven_key_override,
-    &kp_eight_key_override,
-    &kp_nine_key_override,
-    &kp_zero_key_override,
-    NULL // Null terminate the array of overrides!
+#define ALT_FN(key, output) ko_make_basic(MOD_MASK_ALT, key, output)
+
+// Symbol table
+// One row per key, with one slot per modifier class. Each slot is a key override,
+// generated from the ghost layers in layout.yaml: the key override engine reads
+// it for ordinary keys, process_symbols() reads it for the homerow mod-taps
+// and for repeat-key memory. Keys blocked with Alt or Shift+Alt held (empty keys
+// in layout.yaml) share one override per class, which process_symbols()
+// handles before the key override engine runs.
+enum symbol_class {
+    SYMBOL_ALT,
+    SYMBOL_SHIFT_ALT,
+    SYMBOL_SHIFT,
+    SYMBOL_CLASS_COUNT
+};
+
+// Characters typed with a Compose key sequence have keycodes in the user
+// range, one per entry of compose_sequences[] (linux_compose profile only)
+#define COMPOSED(sequence) (QK_USER + (sequence))
+
+// Layers, keymaps[] and the symbol table (symbol_overrides[], symbol_table[],
+// symbol_row_mods[], symbol_rows[]) are generated from layout.yaml by
+// scripts/generate-keymap.js, once per output profile: the host OS and
+// keyboard layout the symbols are typed for. OUTPUT_PROFILE in rules.mk picks
+// one at compile time, so nothing here checks the OS while typing.
+// The overrides are stored in flash: SRAM is the scarcest resource on the Sweep.
+#ifndef KEYMAP_TABLES
+#    define KEYMAP_TABLES "keymap_tables_macos_uk.h"
+#endif
+#include KEYMAP_TABLES
+
+#ifdef USAGE_STATS_ENABLE
+_Static_assert(LAYER_COUNT <= USAGE_STATS_LAYERS, "Raise USAGE_STATS_LAYERS to count every layer");
+_Static_assert(SYMBOL_OVERRIDE_COUNT <= USAGE_STATS_OVERRIDES, "Raise USAGE_STATS_OVERRIDES to count every override");
+#endif
+
+// The key override engine only reads overrides through key_override_get(), so
+// this array exists for QMK's keymap introspection and is otherwise unused.
+// Overrides added here would sit in SRAM; add them to layout.yaml instead.
+const key_override_t *key_overrides[] = {NULL};
+_Static_assert(ARRAY_SIZE(key_overrides) == 1, "Key overrides are generated into flash from layout.yaml");
+
+// Mod-taps are looked up by their tap keycode
+static uint8_t symbol_row_for(uint16_t keycode) {
+    if (IS_QK_MOD_TAP(keycode)) {
+        keycode = QK_MOD_TAP_GET_TAP_KEYCODE(keycode);
+    }
+    if (keycode < ARRAY_SIZE(symbol_rows)) {
+        return pgm_read_byte(&symbol_rows[keycode]);
+    }
+    return extended_symbol_row(keycode);
+}
+
+#if COMPOSE_SEQUENCE_COUNT > 0
+#    define IS_COMPOSED(keycode) ((keycode) >= QK_USER && (keycode) < QK_USER + COMPOSE_SEQUENCE_COUNT)
+
+// Host key that starts a Compose sequence
+#    ifndef COMPOSE_KEY
+#        define COMPOSE_KEY KC_RALT
+#    endif
+
+// One-shot mods are used up by the symbol, rather than going out with the
+// first key of the sequence and typing something else. A shifted key takes
+// its Shift off the weak mods, so those that were already on, from a held
+// modded key or the repeat key, are put back after each key.
+static void tap_composed(uint16_t keycode) {
+    uint8_t weak_mods = get_weak_mods();
+    clear_oneshot_mods();
+    tap_code(COMPOSE_KEY);
+    for (uint8_t i = 0; i < COMPOSE_SEQUENCE_LENGTH; i++) {
+        uint16_t key = pgm_read_word(&compose_sequences[keycode - QK_USER][i]);
+        if (key != KC_NO) {
+            tap_code16(key);
+            add_weak_mods(weak_mods);
+        }
+    }
+}
+#else
+#    define IS_COMPOSED(keycode) false
+#    define tap_composed(keycode)
+#endif
+
+// Row of the most recently pressed key that has symbols.
+// QMK's key override engine normally scans every override on each key event.
+// It only ever looks for overrides of the key it is processing, or of the last
+// key pressed when a modifier changes, so it is only shown this row.
+static uint8_t active_symbol_row = NO_SYMBOLS;
+
+// The engine needs overrides in RAM, so the active row is copied out of flash.
+// It keeps a pointer to the override it has activated, which belongs to this
+// row or the one before it (any other key press deactivates it first), so two
+// copies are kept and a new row never overwrites the one in use.
+static key_override_t symbol_cache[2][SYMBOL_CLASS_COUNT];
+static uint8_t        symbol_cache_ids[2][SYMBOL_CLASS_COUNT]; // symbol_overrides[] index, for usage counts
+static uint8_t        symbol_cache_page;
+static uint8_t        symbol_cache_count;
+
+// Copies of the slots process_symbols() handles itself point .enabled here, so
+// the engine never activates them
+static bool symbol_in_engine = false;
+
+static void load_symbol_row(uint8_t row) {
+    if (row == active_symbol_row) {
+        return;
+    }
+    active_symbol_row = row;
+    symbol_cache_page ^= 1;
+    symbol_cache_count = 0;
+
+    // Filled slots in class order, so the engine sees the same candidates in
+    // the same order as it would in a flat array
+    for (uint8_t i = 0; i < SYMBOL_CLASS_COUNT; i++) {
+        uint8_t override = pgm_read_byte(&symbol_table[row][i]);
+        if (override != NO_OVERRIDE) {
+            key_override_t *symbol = &symbol_cache[symbol_cache_page][symbol_cache_count];
+            symbol_cache_ids[symbol_cache_page][symbol_cache_count++] = override;
+            memcpy_P(symbol, &symbol_overrides[override], sizeof(key_override_t));
+            // The engine can't type a Compose sequence. Blocked keys share an
+            // override with a KC_NO trigger, which the engine would activate
+            // on modifiers alone, with no key pressed.
+            if (symbol->replacement == KC_NO || IS_COMPOSED(symbol->replacement)) {
+                symbol->enabled = &symbol_in_engine;
+            }
+        }
+    }
+}
+
+uint16_t key_override_count(void) {
+    return symbol_cache_count;
+}
+
+const key_override_t *key_override_get(uint16_t key_override_idx) {
+    if (key_override_idx >= symbol_cache_count) {
+        return NULL;
+    }
+    return &symbol_cache[symbol_cache_page][key_override_idx];
+}
+
+// Same activation test as the key override engine: all trigger mods held
+// (either side), no negative mods held, and the current layer enabled
+static bool symbol_matches(const key_override_t *symbol, uint8_t mods, uint8_t layer) {
+    uint8_t held      = (mods | (mods >> 4)) & 0x0F;
+    uint8_t triggered = (symbol->trigger_mods | (symbol->trigger_mods >> 4)) & 0x0F;
+
+    return (held & triggered) == triggered && !(mods & symbol->negative_mod_mask) && (symbol->layers & ((layer_state_t)1 << layer));
+}
+
+// Modifier bits of a modded keycode such as LSFT(KC_2), in get_mods() format
+static uint8_t symbol_mods(uint16_t symbol) {
+    uint8_t mods = QK_MODS_GET_MODS(symbol);
+    return (mods & 0x10) ? (mods & 0x0F) << 4 : mods;
+}
+
+// Tap a symbol in two keyboard reports: the key together with its modifiers,
+// then its release. tap_code16() sends the modifiers, the key, the key release
+// and the modifier release as four reports, each waiting for a USB poll.
+static void tap_symbol(uint16_t symbol) {
+    if (IS_COMPOSED(symbol)) {
+        tap_composed(symbol);
+        return;
+    }
+    if (symbol > QK_MODS_MAX) {
+        tap_code16(symbol);
+        return;
+    }
+
+    // Weak mods that are already on, such as the held repeat key's, stay on
+    uint8_t mods = symbol_mods(symbol) & ~get_weak_mods();
+    add_weak_mods(mods); // Sent with the key press below
+    register_code(QK_MODS_GET_BASIC_KEYCODE(symbol));
+    wait_ms(TAP_CODE_DELAY);
+    del_weak_mods(mods); // Sent with the key release below
+    unregister_code(QK_MODS_GET_BASIC_KEYCODE(symbol));
+}
+
+enum combo_names {
+    QWERTY_COMBO,
+    SPOTLIGHT_COMBO,
 };
 
 const uint16_t PROGMEM qwerty_combo[] = {KC_ESC, KC_TAB, KC_BSPC, COMBO_END};
 const uint16_t PROGMEM spotlight_combo[] = {MT(MOD_LGUI, KC_D), MT(MOD_RGUI, KC_K), KC_SPACE, COMBO_END};
 combo_t key_combos[] = {
-    COMBO(qwerty_combo, TO(0)),
-    COMBO(spotlight_combo, LGUI(KC_SPACE))
+    [QWERTY_COMBO] = COMBO(qwerty_combo, TO(BASE)),
+    [SPOTLIGHT_COMBO] = COMBO(spotlight_combo, LGUI(KC_SPACE))
+};
+
+// Layers each combo can start on, and how long its keys are held back waiting
+// for the rest of the chord. A key is only buffered if some combo it belongs
+// to can start on the current layer (see combo_should_trigger()).
+typedef struct {
+    layer_state_t layers;
+    uint16_t      term;
+} combo_rule_t;
+
+static const combo_rule_t PROGMEM combo_rules[] = {
+    [QWERTY_COMBO] = {.layers = (layer_state_t)1 << NAV, .term = COMBO_TERM},
+    // Three fingers on two hands: D, K and the Space thumb
+    [SPOTLIGHT_COMBO] = {.layers = (layer_state_t)1 << BASE, .term = COMBO_TERM},
 };
+_Static_assert(ARRAY_SIZE(combo_rules) == ARRAY_SIZE(key_combos), "Every combo needs a rule");
 
 #if defined(ENCODER_ENABLE) && defined(ENCODER_MAP_ENABLE)
 const uint16_t PROGMEM encoder_map[][NUM_ENCODERS][NUM_DIRECTIONS] = {
@@ -262,240 +231,249 @@ const uint16_t PROGMEM encoder_map[][NUM_ENCODERS][NUM_DIRECTIONS] = {
 // won't work on iOS devices. (Default value is 500)
 #define USB_MAX_POWER_CONSUMPTION 100
 
-// Custom handling for Alt+homerow mod-tap keys
-// Key overrides don't work with mod-tap keys, so we handle them manually
-bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+// The slot of the loaded row a key press matches with these mods, or
+// symbol_cache_count. The first matching slot wins, as it does in the key
+// override engine.
+static uint8_t match_symbol(uint8_t mods) {
+    uint8_t layer = get_highest_layer(layer_state | default_layer_state);
+    for (uint8_t i = 0; i < symbol_cache_count; i++) {
+        if (symbol_matches(&symbol_cache[symbol_cache_page][i], mods, layer)) {
+            return i;
+        }
+    }
+    return symbol_cache_count;
+}
+
+// A key press deactivates the engine's override, but it doesn't see the presses
+// process_symbols() swallows. They are shown to it with no overrides to match,
+// so it releases its replacement before the symbol is typed.
+static void deactivate_engine_symbol(uint16_t keycode, keyrecord_t *record) {
+    uint8_t count      = symbol_cache_count;
+    symbol_cache_count = 0;
+    process_key_override(keycode, record);
+    symbol_cache_count = count;
+}
+
+// Key overrides don't work with mod-tap keys, and they happen after repeat key
+// tracking, so process_symbols() sends the homerow symbols itself and tells
+// repeat what was actually typed (the overridden output, not Alt+key)
+static bool process_symbols(uint16_t keycode, keyrecord_t *record) {
+    // A mod-tap held as its modifier isn't typing its key
+    if (IS_QK_MOD_TAP(keycode) && record->tap.count == 0) {
+        return true;
+    }
+    uint8_t row = symbol_row_for(keycode);
+    if (row == NO_SYMBOLS) {
+        return true;
+    }
+    // Point the key override engine at this key's row before it runs
+    load_symbol_row(row);
+
     // Check which modifiers are active (including one-shot modifiers)
-    uint8_t mods = get_mods();
-    uint8_t oneshot_mods = get_oneshot_mods();
-    uint8_t all_mods = mods | oneshot_mods;
+    uint8_t all_mods = get_mods() | get_oneshot_mods();
+
+    // Most presses are letters typed without Alt (or a lone Shift): none of
+    // their slots can match, so skip matching them one by one
+    if (!(all_mods & pgm_read_byte(&symbol_row_mods[row]))) {
+        latency_mark(LATENCY_OVERRIDE, keycode);
+        return true;
+    }
 
-    bool alt_held = (all_mods & MOD_MASK_ALT);
-    bool shift_held = (all_mods & MOD_MASK_SHIFT);
-    bool only_alt = alt_held && !shift_held && !(all_mods & MOD_MASK_CG); // Alt only, no Shift/Ctrl/GUI
+    uint8_t slot = match_symbol(all_mods);
+    latency_mark(slot < symbol_cache_count ? LATENCY_OVERRIDE | LATENCY_HIT : LATENCY_OVERRIDE, keycode);
+    if (slot == symbol_cache_count) {
+        return true;
+    }
+    const key_override_t *symbol = &symbol_cache[symbol_cache_page][slot];
+    usage_stats_override(symbol_cache_ids[symbol_cache_page][slot]);
+
+    // Repeat remembers the symbol rather than Alt+key, with any mods held that
+    // go out with it, but not when the repeat key types it again, as it
+    // releases the mods it remembered once the key is done. Blocked keys
+    // aren't remembered (remember_last_key_user()), and Compose sequences
+    // don't take one-shot mods.
+    uint16_t output    = symbol->replacement;
+    bool     remember  = get_repeat_key_count() == 0;
+    uint8_t  kept_mods = (get_mods() | get_weak_mods()) & ~symbol->suppressed_mods;
+    if (remember && output != KC_NO && output <= QK_MODS_MAX) {
+        set_last_keycode(QK_MODS_GET_BASIC_KEYCODE(output));
+        set_last_mods(symbol_mods(output) | kept_mods | (get_oneshot_mods() & ~symbol->suppressed_mods));
+    } else if (remember && IS_COMPOSED(output)) {
+        set_last_keycode(output);
+        set_last_mods(kept_mods);
+    }
 
+    // Mod-taps, and Compose sequences the engine can't type
+    if (IS_QK_MOD_TAP(keycode) || IS_COMPOSED(output)) {
+        uint8_t temp_mods      = get_mods();
+        uint8_t temp_weak_mods = get_weak_mods();
+
+        deactivate_engine_symbol(keycode, record);
+        del_mods(symbol->suppressed_mods); // Clear Alt (and Shift) temporarily
+        del_weak_mods(symbol->suppressed_mods); // Including any the repeat key added
+        del_oneshot_mods(symbol->suppressed_mods); // Consume one-shot mods
+        if (output != KC_NO) {
+            tap_symbol(output);
+        }
+        set_mods(temp_mods); // Restore regular and weak mods, but not one-shot ones
+        set_weak_mods(temp_weak_mods);
+        return false;
+    }
+
+    // Blocked keys' override is disabled in the engine (load_symbol_row()), so
+    // swallow them here, using up one-shot mods as the engine would
+    if (output == KC_NO) {
+        deactivate_engine_symbol(keycode, record);
+        del_oneshot_mods(symbol->suppressed_mods);
+        return false;
+    }
+
+    return true; // Let the key override engine send the symbol
+}
+
+// Blocked keys type nothing, so repeat keeps what it remembered before them.
+// QMK asks before process_record_user() runs, so this loads the key's row.
+// Compose keys are remembered without the one-shot mods they use up.
+bool remember_last_key_user(uint16_t keycode, keyrecord_t *record, uint8_t *remembered_mods) {
+    if (IS_COMPOSED(keycode)) {
+        *remembered_mods = get_mods() | get_weak_mods(); // See tap_composed()
+    }
+    uint8_t row  = symbol_row_for(keycode);
+    uint8_t mods = get_mods() | get_oneshot_mods();
+    if (row == NO_SYMBOLS || !(mods & pgm_read_byte(&symbol_row_mods[row]))) {
+        return true;
+    }
+    load_symbol_row(row);
+    uint8_t slot = match_symbol(mods);
+    return slot == symbol_cache_count || symbol_cache[symbol_cache_page][slot].replacement != KC_NO;
+}
+
+bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    adaptive_tapping_record(keycode, record);
+    if (!record->event.pressed) {
+        return true;
+    }
+    if (IS_COMPOSED(keycode)) {
+        tap_composed(keycode);
+        return false;
+    }
+
+    latency_mark(LATENCY_ENTER, keycode);
+    bool result = process_symbols(keycode, record);
+    latency_mark(LATENCY_EXIT, keycode);
+    return result;
+}
+
+#ifdef RGBLIGHT_ENABLE
+// Underglow animations render in the main loop, between matrix scans, and on
+// AVR writing the LEDs blocks interrupts. Pausing them while typing keeps LED
+// work from holding back key presses. They carry on from the same frame once
+// the keyboard has been idle for RGBLIGHT_TYPING_PAUSE_MS.
+static bool     underglow_paused;
+static uint16_t underglow_last_press;
+
+static void pause_underglow(void) {
+    underglow_last_press = timer_read();
+    if (!underglow_paused && rgblight_is_enabled()) {
+        rgblight_timer_disable();
+        underglow_paused = true;
+    }
+}
+
+static void resume_underglow(void) {
+    if (underglow_paused && timer_elapsed(underglow_last_press) >= RGBLIGHT_TYPING_PAUSE_MS) {
+        rgblight_timer_enable();
+        underglow_paused = false;
+    }
+}
+#else
+#    define pause_underglow()
+#    define resume_underglow()
+#endif
+
+void keyboard_post_init_user(void) {
+    adaptive_tapping_init();
+    usage_stats_init();
+}
+
+void housekeeping_task_user(void) {
+    latency_task();
+    adaptive_tapping_task();
+    key_trace_task();
+    usage_stats_task();
+    resume_underglow();
+}
+
+// Recent key presses, so get_flow_tap_term() can tell which hand the previous
+// key was on. The tapping engine may decide on a buffered key after later keys
+// have been pressed, so the key before the one being decided is looked up here.
+typedef struct {
+    keypos_t key;
+    uint16_t time;
+} key_press_t;
+
+static key_press_t recent_presses[4];
+static uint8_t     recent_press_head;
+
+bool pre_process_record_user(uint16_t keycode, keyrecord_t *record) {
+    key_trace_record(record);
+    usage_stats_key(record);
     if (record->event.pressed) {
-        // Handle Alt+homerow mod-tap keys
-        if (only_alt) {
-            uint8_t temp_mods = get_mods();
-
-            switch(keycode) {
-                case MT(MOD_LGUI, KC_D):  // Alt+D → '
-                    del_mods(MOD_MASK_ALT); // Clear Alt temporarily
-                    del_oneshot_mods(MOD_MASK_ALT); // Clear one-shot Alt (consume it)
-                    tap_code16(KC_QUOTE); // Send '
-                    set_last_keycode(KC_QUOTE);
-                    set_last_mods(0);
-                    set_mods(temp_mods); // Restore regular mods only
-                    return false;
-                case MT(MOD_LCTL, KC_F):  // Alt+F → "
-                    del_mods(MOD_MASK_ALT);
-                    del_oneshot_mods(MOD_MASK_ALT);
-                    tap_code16(KC_DQUO); // Send "
-                    set_last_keycode(KC_QUOTE);
-                    set_last_mods(MOD_BIT(KC_LSFT));
-                    set_mods(temp_mods);
-                    return false;
-                case MT(MOD_RCTL, KC_J):  // Alt+J → [
-                    del_mods(MOD_MASK_ALT);
-                    del_oneshot_mods(MOD_MASK_ALT);
-                    tap_code16(KC_LBRC); // Send [
-                    set_last_keycode(KC_LBRC);
-                    set_last_mods(0);
-                    set_mods(temp_mods);
-                    return false;
-                case MT(MOD_RGUI, KC_K):  // Alt+K → |
-                    del_mods(MOD_MASK_ALT);
-                    del_oneshot_mods(MOD_MASK_ALT);
-                    tap_code16(KC_PIPE); // Send |
-                    set_last_keycode(KC_BACKSLASH);
-                    set_last_mods(MOD_BIT(KC_LSFT));
-                    set_mods(temp_mods);
-                    return false;
-            }
+        latency_mark(LATENCY_PRESS, keycode);
+        pause_underglow();
+        recent_presses[recent_press_head++ % ARRAY_SIZE(recent_presses)] = (key_press_t){.key = record->event.key, .time = record->event.time};
+    }
+    return true;
+}
 
-            // Handle Alt+key repeat behavior for non-homerow keys
-            // Key overrides happen after repeat key tracking, so we manually
-            // set what repeat should remember (the overridden output, not Alt+key)
-            switch(keycode) {
-                case KC_Q:  // Alt+Q → Esc
-                    set_last_keycode(KC_ESC);
-                    set_last_mods(0);
-                    break;
-                case KC_W:  // Alt+W → @
-                    set_last_keycode(KC_2);
-                    set_last_mods(MOD_BIT(KC_LSFT));
-                    break;
-                case KC_E:  // Alt+E → # (UK keyboard: Alt+3)
-                    set_last_keycode(KC_3);
-                    set_last_mods(MOD_BIT(KC_LALT));
-                    break;
-                case KC_R:  // Alt+R → $
-                    set_last_keycode(KC_4);
-                    set_last_mods(MOD_BIT(KC_LSFT));
-                    break;
-                case KC_T:  // Alt+T → %
-                    set_last_keycode(KC_5);
-                    set_last_mods(MOD_BIT(KC_LSFT));
-                    break;
-                case KC_Y:  // Alt+Y → ^
-                    set_last_keycode(KC_6);
-                    set_last_mods(MOD_BIT(KC_LSFT));
-                    break;
-                case KC_U:  // Alt+U → &
-                    set_last_keycode(KC_7);
-                    set_last_mods(MOD_BIT(KC_LSFT));
-                    break;
-                case KC_I:  // Alt+I → *
-                    set_last_keycode(KC_8);
-                    set_last_mods(MOD_BIT(KC_LSFT));
-                    break;
-                case KC_O:  // Alt+O → -
-                case KC_X:  // Alt+X → -
-                    set_last_keycode(KC_MINUS);
-                    set_last_mods(0);
-                    break;
-                case KC_P:  // Alt+P → Backspace
-                    set_last_keycode(KC_BSPC);
-                    set_last_mods(0);
-                    break;
-                case KC_A:  // Alt+A → Tab
-                    set_last_keycode(KC_TAB);
-                    set_last_mods(0);
-                    break;
-                case KC_S:  // Alt+S → `
-                    set_last_keycode(KC_GRAVE);
-                    set_last_mods(0);
-                    break;
-                case KC_H:  // Alt+H → backslash
-                    set_last_keycode(KC_BACKSLASH);
-                    set_last_mods(0);
-                    break;
-                case KC_L:  // Alt+L → ]
-                    set_last_keycode(KC_RBRC);
-                    set_last_mods(0);
-                    break;
-                case KC_Z:  // Alt+Z → ~
-                    set_last_keycode(KC_GRAVE);
-                    set_last_mods(MOD_BIT(KC_LSFT));
-                    break;
-                case KC_C:  // Alt+C → +
-                    set_last_keycode(KC_EQUAL);
-                    set_last_mods(MOD_BIT(KC_LSFT));
-                    break;
-                case KC_V:  // Alt+V → =
-                    set_last_keycode(KC_EQUAL);
-                    set_last_mods(0);
-                    break;
-                case KC_B:  // Alt+B → _
-                    set_last_keycode(KC_MINUS);
-                    set_last_mods(MOD_BIT(KC_LSFT));
-                    break;
-                case KC_M:  // Alt+M → (
-                    set_last_keycode(KC_9);
-                    set_last_mods(MOD_BIT(KC_LSFT));
-                    break;
-                case KC_DOT:  // Alt+. → )
-                    set_last_keycode(KC_0);
-                    set_last_mods(MOD_BIT(KC_LSFT));
-                    break;
-                case KC_SCLN:  // Alt+; → Enter
-                    set_last_keycode(KC_ENTER);
-                    set_last_mods(0);
-                    break;
-                case KC_SLSH:  // Alt+/ → delete word (Alt+Backspace)
-                    set_last_keycode(KC_BSPC);
-                    set_last_mods(MOD_BIT(KC_LALT));
-                    break;
-            }
+// The press before this record's, or NULL if it has dropped out of the history
+static const key_press_t *previous_press(keyrecord_t *record) {
+    for (uint8_t i = 1; i < ARRAY_SIZE(recent_presses); i++) {
+        key_press_t *press = &recent_presses[(uint8_t)(recent_press_head - i) % ARRAY_SIZE(recent_presses)];
+        if (press->time == record->event.time && KEYEQ(press->key, record->event.key)) {
+            return &recent_presses[(uint8_t)(recent_press_head - i - 1) % ARRAY_SIZE(recent_presses)];
         }
+    }
+    return NULL;
+}
 
-        // Handle Shift+Alt+homerow mod-tap keys
-        // Don't trigger when Command is held, to allow Cmd+Shift+Alt+key shortcuts
-        if (alt_held && shift_held && !(all_mods & MOD_MASK_GUI)) {
-            uint8_t temp_mods = get_mods();
-
-            switch(keycode) {
-                case MT(MOD_RCTL, KC_J):  // Shift+Alt+J → {
-                    del_mods(MOD_MASK_ALT | MOD_MASK_SHIFT); // Clear Alt+Shift temporarily
-                    del_oneshot_mods(MOD_MASK_ALT | MOD_MASK_SHIFT); // Consume one-shot mods
-                    tap_code16(KC_LCBR); // Send {
-                    set_last_keycode(KC_LBRC);
-                    set_last_mods(MOD_BIT(KC_LSFT));
-                    set_mods(temp_mods); // Restore regular mods only
-                    return false;
-                case MT(MOD_RGUI, KC_K):  // Shift+Alt+K → !
-                    del_mods(MOD_MASK_ALT | MOD_MASK_SHIFT);
-                    del_oneshot_mods(MOD_MASK_ALT | MOD_MASK_SHIFT);
-                    tap_code16(KC_EXCLAIM); // Send !
-                    set_last_keycode(KC_1);
-                    set_last_mods(MOD_BIT(KC_LSFT));
-                    set_mods(temp_mods);
-                    return false;
-                case MT(MOD_LGUI, KC_D):
-                case MT(MOD_LCTL, KC_F):
-                    return false; // Block D, F with Shift+Alt (no symbol assigned)
-            }
+// Flow Tap: during a typing streak (both keys are typing keys, see QMK's
+// is_flow_tap_key()), a homerow mod-tap pressed within FLOW_TAP_TERM of the
+// previous key is tapped straight away instead of waiting for its release.
+// A mod-tap straight after another mod-tap on the same hand is stacking mods
+// (e.g. Cmd+Ctrl on D+F), so that is left to Chordal Hold.
+uint16_t get_flow_tap_term(uint16_t keycode, keyrecord_t *record, uint16_t prev_keycode) {
+    if (!is_flow_tap_key(keycode) || !is_flow_tap_key(prev_keycode)) {
+        return 0;
+    }
 
-            // Handle Shift+Alt+key repeat behavior for non-homerow keys
-            switch(keycode) {
-                case KC_A:  // Shift+Alt+A → Shift+Tab
-                    set_last_keycode(KC_TAB);
-                    set_last_mods(MOD_BIT(KC_LSFT));
-                    break;
-                case KC_W:  // Shift+Alt+W → € (Alt+2 on macOS)
-                    set_last_keycode(KC_2);
-                    set_last_mods(MOD_BIT(KC_LALT));
-                    break;
-                case KC_R:  // Shift+Alt+R → £
-                    set_last_keycode(KC_3);
-                    set_last_mods(MOD_BIT(KC_LSFT));
-                    break;
-                case KC_L:  // Shift+Alt+L → }
-                    set_last_keycode(KC_RBRC);
-                    set_last_mods(MOD_BIT(KC_LSFT));
-                    break;
-                case KC_X:  // Shift+Alt+X → " (left double quote: Alt+[)
-                    set_last_keycode(KC_LEFT_BRACKET);
-                    set_last_mods(MOD_BIT(KC_LALT));
-                    break;
-                case KC_C:  // Shift+Alt+C → ' (left single quote: Alt+])
-                    set_last_keycode(KC_RIGHT_BRACKET);
-                    set_last_mods(MOD_BIT(KC_LALT));
-                    break;
-                case KC_V:  // Shift+Alt+V → ' (right single quote: Alt+Shift+])
-                    set_last_keycode(KC_RIGHT_BRACKET);
-                    set_last_mods(MOD_BIT(KC_LALT) | MOD_BIT(KC_LSFT));
-                    break;
-                case KC_B:  // Shift+Alt+B → " (right double quote: Alt+Shift+[)
-                    set_last_keycode(KC_LEFT_BRACKET);
-                    set_last_mods(MOD_BIT(KC_LALT) | MOD_BIT(KC_LSFT));
-                    break;
-                case KC_M:  // Shift+Alt+M → <
-                    set_last_keycode(KC_COMMA);
-                    set_last_mods(MOD_BIT(KC_LSFT));
-                    break;
-                case KC_DOT:  // Shift+Alt+. → >
-                    set_last_keycode(KC_DOT);
-                    set_last_mods(MOD_BIT(KC_LSFT));
-                    break;
-            }
-        }
+    const key_press_t *previous = IS_QK_MOD_TAP(prev_keycode) ? previous_press(record) : NULL;
+    if (previous != NULL && chordal_hold_handedness(previous->key) == chordal_hold_handedness(record->event.key)) {
+        return 0;
+    }
+    return FLOW_TAP_TERM;
+}
 
-        // Handle Shift-only key repeat behavior for key overrides
-        // Key overrides happen after repeat key tracking, so we manually
-        // set what repeat should remember (the overridden output, not Shift+key)
-        if (shift_held && !alt_held && !(all_mods & MOD_MASK_CG)) {
-            switch(keycode) {
-                case KC_DOT:  // Shift+. → ,
-                    set_last_keycode(KC_COMMA);
-                    set_last_mods(0);
-                    break;
-            }
-        }
+uint16_t get_combo_term(uint16_t combo_index, combo_t *combo) {
+    return pgm_read_word(&combo_rules[combo_index].term);
+}
+
+// Decides whether a key press is buffered as the start of a combo. Combos only
+// start on their own layers, and not in the middle of a typing streak (the
+// same FLOW_TAP_TERM as Flow Tap), so D, K and Space are sent straight away
+// while typing instead of waiting out the combo term.
+bool combo_should_trigger(uint16_t combo_index, combo_t *combo, uint16_t keycode, keyrecord_t *record) {
+    if (!record->event.pressed || combo->state != 0) {
+        return true; // Releases, and the rest of a chord that has already started
+    }
+
+    layer_state_t layers = pgm_read_dword(&combo_rules[combo_index].layers);
+    if (!(layers & ((layer_state_t)1 << get_highest_layer(layer_state | default_layer_state)))) {
+        return false;
     }
 
-    return true; // Continue normal processing
+    const key_press_t *previous = previous_press(record);
+    return previous == NULL || TIMER_DIFF_16(record->event.time, previous->time) >= FLOW_TAP_TERM;
 }
 
 // Define handedness for Chordal Hold using layout array
@@ -0,0 +1,378 @@
+// Generated by scripts/generate-keymap.js from layout.yaml. Do not edit:
+// change layout.yaml and run `node scripts/generate-keymap.js` instead.
+#pragma once
+
+// Keycodes for the linux_us output profile (Linux, US layout)
+#define KC_NAV_PREV_TAB LCTL(LSFT(KC_TAB))
+#define KC_NAV_NEXT_TAB RCTL(KC_TAB)
+#define KC_NAV_HISTORY_BACK LALT(KC_LEFT)
+#define KC_NAV_HISTORY_FORWARD LALT(KC_RIGHT)
+#define KC_DELETE_WORD LCTL(KC_BSPC)
+
+// Not available with this profile, so typed as KC_NO: ˜ € £ “ ‘ ’ ” œ ∑ ´ ® † ¥ ¨ ˆ ø π å ß ∂ ƒ © ˙ ∆ ˚ ¬ … Ω ≈ ç √ ∫ µ ≤ ≥ ÷
+
+#define COMPOSE_SEQUENCE_COUNT 0
+
+enum layer_names {
+    BASE,
+    NAV,
+    MOUSE,
+    SYMBOL,
+    LAYER_COUNT
+};
+
+const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
+    [BASE] = LAYOUT_split_3x5_2(
+        KC_Q, KC_W, KC_E, KC_R, KC_T,
+        KC_Y, KC_U, KC_I, KC_O, KC_P,
+
+        KC_A, KC_S, MT(MOD_LGUI, KC_D), MT(MOD_LCTL, KC_F), KC_G,
+        KC_H, MT(MOD_RCTL, KC_J), MT(MOD_RGUI, KC_K), KC_L, KC_SCLN,
+
+        KC_Z, KC_X, KC_C, KC_V, KC_B,
+        KC_N, KC_M, QK_REPEAT_KEY, KC_DOT, KC_SLSH,
+
+        TO(NAV), OSM(MOD_LSFT),
+        OSM(MOD_LALT), KC_SPACE
+    ),
+    [NAV] = LAYOUT_split_3x5_2(
+        KC_ESC, KC_KP_7, KC_KP_8, KC_KP_9, KC_NO,
+        KC_NAV_HISTORY_BACK, KC_NAV_PREV_TAB, KC_NAV_NEXT_TAB, KC_NAV_HISTORY_FORWARD, KC_BSPC,
+
+        KC_TAB, KC_KP_4, MT(MOD_LGUI, KC_KP_5), MT(MOD_LCTL, KC_KP_6), TO(MOUSE),
+        KC_LEFT, MT(MOD_RCTL, KC_DOWN), MT(MOD_RGUI, KC_UP), KC_RIGHT, KC_ENTER,
+
+        KC_KP_0, KC_KP_1, KC_KP_2, KC_KP_3, KC_NO,
+        KC_NO, KC_NO, QK_REPEAT_KEY, KC_DOT, KC_NO,
+
+        TO(SYMBOL), KC_TRNS,
+        KC_TRNS, TO(BASE)
+    ),
+    [MOUSE] = LAYOUT_split_3x5_2(
+        KC_NO, KC_NO, KC_NO, KC_NO, KC_NO,
+        MS_WHLL, MS_WHLD, MS_WHLU, MS_WHLR, KC_NO,
+
+        KC_NO, MS_BTN3, MS_BTN2, MS_BTN1, KC_NO,
+        MS_LEFT, MS_DOWN, MS_UP, MS_RGHT, KC_NO,
+
+        KC_NO, KC_NO, KC_NO, KC_NO, KC_NO,
+        KC_NO, KC_NO, KC_NO, KC_NO, KC_NO,
+
+        TO(NAV), KC_NO,
+        KC_NO, TO(BASE)
+    ),
+    [SYMBOL] = LAYOUT_split_3x5_2(
+        KC_NO, KC_NO, KC_NO, KC_NO, KC_NO,
+        KC_NO, KC_NO, KC_NO, KC_NO, KC_NO,
+
+        KC_NO, KC_NO, KC_NO, KC_NO, KC_NO,
+        KC_NO, KC_NO, KC_NO, KC_NO, KC_NO,
+
+        KC_NO, KC_NO, KC_NO, KC_NO, KC_NO,
+        KC_NO, KC_NO, KC_NO, KC_NO, KC_NO,
+
+        TO(BASE), KC_TRNS,
+        KC_TRNS, TO(BASE)
+    )
+};
+
+enum symbol_row {
+    NO_SYMBOLS,
+    Q_SYMBOLS,
+    W_SYMBOLS,
+    E_SYMBOLS,
+    R_SYMBOLS,
+    T_SYMBOLS,
+    Y_SYMBOLS,
+    U_SYMBOLS,
+    I_SYMBOLS,
+    O_SYMBOLS,
+    P_SYMBOLS,
+    A_SYMBOLS,
+    S_SYMBOLS,
+    D_SYMBOLS,
+    F_SYMBOLS,
+    G_SYMBOLS,
+    H_SYMBOLS,
+    J_SYMBOLS,
+    K_SYMBOLS,
+    L_SYMBOLS,
+    SCLN_SYMBOLS,
+    Z_SYMBOLS,
+    X_SYMBOLS,
+    C_SYMBOLS,
+    V_SYMBOLS,
+    B_SYMBOLS,
+    N_SYMBOLS,
+    M_SYMBOLS,
+    REPEAT_SYMBOLS,
+    DOT_SYMBOLS,
+    SLSH_SYMBOLS,
+    KP_7_SYMBOLS,
+    KP_8_SYMBOLS,
+    KP_9_SYMBOLS,
+    BSPC_SYMBOLS,
+    KP_4_SYMBOLS,
+    KP_5_SYMBOLS,
+    KP_6_SYMBOLS,
+    KP_0_SYMBOLS,
+    KP_1_SYMBOLS,
+    KP_2_SYMBOLS,
+    KP_3_SYMBOLS,
+    SYMBOL_ROW_COUNT
+};
+
+enum symbol_override {
+    NO_OVERRIDE,
+    Q_ALT_OVERRIDE,
+    SHIFT_ALT_BLOCKED_OVERRIDE,
+    W_ALT_OVERRIDE,
+    E_ALT_OVERRIDE,
+    R_ALT_OVERRIDE,
+    T_ALT_OVERRIDE,
+    Y_ALT_OVERRIDE,
+    U_ALT_OVERRIDE,
+    I_ALT_OVERRIDE,
+    O_ALT_OVERRIDE,
+    P_ALT_OVERRIDE,
+    SHIFT_ALT_EDIT_BLOCKED_OVERRIDE,
+    A_ALT_OVERRIDE,
+    A_SHIFT_ALT_OVERRIDE,
+    S_ALT_OVERRIDE,
+    D_ALT_OVERRIDE,
+    F_ALT_OVERRIDE,
+    ALT_BLOCKED_OVERRIDE,
+    H_ALT_OVERRIDE,
+    J_ALT_OVERRIDE,
+    J_SHIFT_ALT_OVERRIDE,
+    K_ALT_OVERRIDE,
+    K_SHIFT_ALT_OVERRIDE,
+    L_ALT_OVERRIDE,
+    L_SHIFT_ALT_OVERRIDE,
+    SCLN_ALT_OVERRIDE,
+    SCLN_SHIFT_ALT_OVERRIDE,
+    Z_ALT_OVERRIDE,
+    X_ALT_OVERRIDE,
+    C_ALT_OVERRIDE,
+    V_ALT_OVERRIDE,
+    B_ALT_OVERRIDE,
+    M_ALT_OVERRIDE,
+    M_SHIFT_ALT_OVERRIDE,
+    REPEAT_SHIFT_OVERRIDE,
+    DOT_ALT_OVERRIDE,
+    DOT_SHIFT_ALT_OVERRIDE,
+    DOT_SHIFT_OVERRIDE,
+    SLSH_ALT_OVERRIDE,
+    KP_7_ALT_OVERRIDE,
+    KP_8_ALT_OVERRIDE,
+    KP_9_ALT_OVERRIDE,
+    BSPC_SHIFT_OVERRIDE,
+    KP_4_ALT_OVERRIDE,
+    KP_5_ALT_OVERRIDE,
+    KP_6_ALT_OVERRIDE,
+    KP_0_ALT_OVERRIDE,
+    KP_1_ALT_OVERRIDE,
+    KP_2_ALT_OVERRIDE,
+    KP_3_ALT_OVERRIDE,
+    SYMBOL_OVERRIDE_COUNT
+};
+
+_Static_assert(SYMBOL_OVERRIDE_COUNT <= 256, "symbol_table[] indexes overrides with a uint8_t");
+
+static const key_override_t PROGMEM symbol_overrides[SYMBOL_OVERRIDE_COUNT] = {
+    [Q_ALT_OVERRIDE]                  = ALT_SYMBOL(KC_Q, KC_ESC),
+    [SHIFT_ALT_BLOCKED_OVERRIDE]      = SHIFT_ALT_SYMBOL(KC_NO, KC_NO),
+    [W_ALT_OVERRIDE]                  = ALT_SYMBOL(KC_W, KC_AT),
+    [E_ALT_OVERRIDE]                  = ALT_SYMBOL(KC_E, KC_HASH),
+    [R_ALT_OVERRIDE]                  = ALT_SYMBOL(KC_R, KC_DOLLAR),
+    [T_ALT_OVERRIDE]                  = ALT_SYMBOL(KC_T, KC_PERCENT),
+    [Y_ALT_OVERRIDE]                  = ALT_SYMBOL(KC_Y, KC_CIRCUMFLEX),
+    [U_ALT_OVERRIDE]                  = ALT_SYMBOL(KC_U, KC_AMPERSAND),
+    [I_ALT_OVERRIDE]                  = ALT_SYMBOL(KC_I, KC_ASTERISK),
+    [O_ALT_OVERRIDE]                  = ALT_SYMBOL(KC_O, KC_MINUS),
+    [P_ALT_OVERRIDE]                  = ALT_EDIT(KC_P, KC_BSPC),
+    [SHIFT_ALT_EDIT_BLOCKED_OVERRIDE] = SHIFT_ALT_EDIT(KC_NO, KC_NO),
+    [A_ALT_OVERRIDE]                  = ALT_SYMBOL(KC_A, KC_TAB),
+    [A_SHIFT_ALT_OVERRIDE]            = SHIFT_ALT_SYMBOL(KC_A, LSFT(KC_TAB)),
+    [S_ALT_OVERRIDE]                  = ALT_SYMBOL(KC_S, KC_GRAVE),
+    [D_ALT_OVERRIDE]                  = ALT_SYMBOL(KC_D, KC_QUOTE),
+    [F_ALT_OVERRIDE]                  = ALT_SYMBOL(KC_F, KC_DQUO),
+    [ALT_BLOCKED_OVERRIDE]            = ALT_SYMBOL(KC_NO, KC_NO),
+    [H_ALT_OVERRIDE]                  = ALT_SYMBOL(KC_H, KC_BACKSLASH),
+    [J_ALT_OVERRIDE]                  = ALT_SYMBOL(KC_J, KC_LBRC),
+    [J_SHIFT_ALT_OVERRIDE]            = SHIFT_ALT_SYMBOL(KC_J, KC_LCBR),
+    [K_ALT_OVERRIDE]                  = ALT_SYMBOL(KC_K, KC_PIPE),
+    [K_SHIFT_ALT_OVERRIDE]            = SHIFT_ALT_SYMBOL(KC_K, KC_EXCLAIM),
+    [L_ALT_OVERRIDE]                  = ALT_SYMBOL(KC_L, KC_RBRC),
+    [L_SHIFT_ALT_OVERRIDE]            = SHIFT_ALT_SYMBOL(KC_L, KC_RCBR),
+    [SCLN_ALT_OVERRIDE]               = ALT_EDIT(KC_SCLN, KC_ENTER),
+    [SCLN_SHIFT_ALT_OVERRIDE]         = SHIFT_ALT_EDIT(KC_SCLN, LSFT(KC_ENTER)),
+    [Z_ALT_OVERRIDE]                  = ALT_SYMBOL(KC_Z, KC_TILDE),
+    [X_ALT_OVERRIDE]                  = ALT_SYMBOL(KC_X, KC_MINUS),
+    [C_ALT_OVERRIDE]                  = ALT_SYMBOL(KC_C, KC_PLUS),
+    [V_ALT_OVERRIDE]                  = ALT_SYMBOL(KC_V, KC_EQUAL),
+    [B_ALT_OVERRIDE]                  = ALT_SYMBOL(KC_B, KC_UNDERSCORE),
+    [M_ALT_OVERRIDE]                  = ALT_SYMBOL(KC_M, KC_LPRN),
+    [M_SHIFT_ALT_OVERRIDE]            = SHIFT_ALT_SYMBOL(KC_M, KC_LABK),
+    [REPEAT_SHIFT_OVERRIDE]           = SHIFTED(QK_REPEAT_KEY, QK_ALT_REPEAT_KEY),
+    [DOT_ALT_OVERRIDE]                = ALT_SYMBOL(KC_DOT, KC_RPRN),
+    [DOT_SHIFT_ALT_OVERRIDE]          = SHIFT_ALT_SYMBOL(KC_DOT, KC_RABK),
+    [DOT_SHIFT_OVERRIDE]              = SHIFTED(KC_DOT, KC_COMM),
+    [SLSH_ALT_OVERRIDE]               = ALT_EDIT(KC_SLSH, KC_DELETE_WORD),
+    [KP_7_ALT_OVERRIDE]               = ALT_FN(KC_KP_7, KC_F7),
+    [KP_8_ALT_OVERRIDE]               = ALT_FN(KC_KP_8, KC_F8),
+    [KP_9_ALT_OVERRIDE]               = ALT_FN(KC_KP_9, KC_F9),
+    [BSPC_SHIFT_OVERRIDE]             = SHIFTED(KC_BSPC, KC_DEL),
+    [KP_4_ALT_OVERRIDE]               = ALT_FN(KC_KP_4, KC_F4),
+    [KP_5_ALT_OVERRIDE]               = ALT_FN(KC_KP_5, KC_F5),
+    [KP_6_ALT_OVERRIDE]               = ALT_FN(KC_KP_6, KC_F6),
+    [KP_0_ALT_OVERRIDE]               = ALT_FN(KC_KP_0, KC_F10),
+    [KP_1_ALT_OVERRIDE]               = ALT_FN(KC_KP_1, KC_F1),
+    [KP_2_ALT_OVERRIDE]               = ALT_FN(KC_KP_2, KC_F2),
+    [KP_3_ALT_OVERRIDE]               = ALT_FN(KC_KP_3, KC_F3)
+};
+
+// Override in each slot of each row, as an index into symbol_overrides[]
+static const uint8_t PROGMEM symbol_table[SYMBOL_ROW_COUNT][SYMBOL_CLASS_COUNT] = {
+    //                  Alt                   Shift+Alt                        Shift
+    [Q_SYMBOLS]      = {Q_ALT_OVERRIDE,       SHIFT_ALT_BLOCKED_OVERRIDE,      NO_OVERRIDE},
+    [W_SYMBOLS]      = {W_ALT_OVERRIDE,       SHIFT_ALT_BLOCKED_OVERRIDE,      NO_OVERRIDE},
+    [E_SYMBOLS]      = {E_ALT_OVERRIDE,       SHIFT_ALT_BLOCKED_OVERRIDE,      NO_OVERRIDE},
+    [R_SYMBOLS]      = {R_ALT_OVERRIDE,       SHIFT_ALT_BLOCKED_OVERRIDE,      NO_OVERRIDE},
+    [T_SYMBOLS]      = {T_ALT_OVERRIDE,       SHIFT_ALT_BLOCKED_OVERRIDE,      NO_OVERRIDE},
+    [Y_SYMBOLS]      = {Y_ALT_OVERRIDE,       SHIFT_ALT_BLOCKED_OVERRIDE,      NO_OVERRIDE},
+    [U_SYMBOLS]      = {U_ALT_OVERRIDE,       SHIFT_ALT_BLOCKED_OVERRIDE,      NO_OVERRIDE},
+    [I_SYMBOLS]      = {I_ALT_OVERRIDE,       SHIFT_ALT_BLOCKED_OVERRIDE,      NO_OVERRIDE},
+    [O_SYMBOLS]      = {O_ALT_OVERRIDE,       SHIFT_ALT_BLOCKED_OVERRIDE,      NO_OVERRIDE},
+    [P_SYMBOLS]      = {P_ALT_OVERRIDE,       SHIFT_ALT_EDIT_BLOCKED_OVERRIDE, NO_OVERRIDE},
+    [A_SYMBOLS]      = {A_ALT_OVERRIDE,       A_SHIFT_ALT_OVERRIDE,            NO_OVERRIDE},
+    [S_SYMBOLS]      = {S_ALT_OVERRIDE,       SHIFT_ALT_BLOCKED_OVERRIDE,      NO_OVERRIDE},
+    [D_SYMBOLS]      = {D_ALT_OVERRIDE,       SHIFT_ALT_BLOCKED_OVERRIDE,      NO_OVERRIDE},
+    [F_SYMBOLS]      = {F_ALT_OVERRIDE,       SHIFT_ALT_BLOCKED_OVERRIDE,      NO_OVERRIDE},
+    [G_SYMBOLS]      = {ALT_BLOCKED_OVERRIDE, SHIFT_ALT_BLOCKED_OVERRIDE,      NO_OVERRIDE},
+    [H_SYMBOLS]      = {H_ALT_OVERRIDE,       SHIFT_ALT_BLOCKED_OVERRIDE,      NO_OVERRIDE},
+    [J_SYMBOLS]      = {J_ALT_OVERRIDE,       J_SHIFT_ALT_OVERRIDE,            NO_OVERRIDE},
+    [K_SYMBOLS]      = {K_ALT_OVERRIDE,       K_SHIFT_ALT_OVERRIDE,            NO_OVERRIDE},
+    [L_SYMBOLS]      = {L_ALT_OVERRIDE,       L_SHIFT_ALT_OVERRIDE,            NO_OVERRIDE},
+    [SCLN_SYMBOLS]   = {SCLN_ALT_OVERRIDE,    SCLN_SHIFT_ALT_OVERRIDE,         NO_OVERRIDE},
+    [Z_SYMBOLS]      = {Z_ALT_OVERRIDE,       SHIFT_ALT_BLOCKED_OVERRIDE,      NO_OVERRIDE},
+    [X_SYMBOLS]      = {X_ALT_OVERRIDE,       SHIFT_ALT_BLOCKED_OVERRIDE,      NO_OVERRIDE},
+    [C_SYMBOLS]      = {C_ALT_OVERRIDE,       SHIFT_ALT_BLOCKED_OVERRIDE,      NO_OVERRIDE},
+    [V_SYMBOLS]      = {V_ALT_OVERRIDE,       SHIFT_ALT_BLOCKED_OVERRIDE,      NO_OVERRIDE},
+    [B_SYMBOLS]      = {B_ALT_OVERRIDE,       SHIFT_ALT_BLOCKED_OVERRIDE,      NO_OVERRIDE},
+    [N_SYMBOLS]      = {ALT_BLOCKED_OVERRIDE, SHIFT_ALT_BLOCKED_OVERRIDE,      NO_OVERRIDE},
+    [M_SYMBOLS]      = {M_ALT_OVERRIDE,       M_SHIFT_ALT_OVERRIDE,            NO_OVERRIDE},
+    [REPEAT_SYMBOLS] = {NO_OVERRIDE,          NO_OVERRIDE,                     REPEAT_SHIFT_OVERRIDE},
+    [DOT_SYMBOLS]    = {DOT_ALT_OVERRIDE,     DOT_SHIFT_ALT_OVERRIDE,          DOT_SHIFT_OVERRIDE},
+    [SLSH_SYMBOLS]   = {SLSH_ALT_OVERRIDE,    SHIFT_ALT_EDIT_BLOCKED_OVERRIDE, NO_OVERRIDE},
+    [KP_7_SYMBOLS]   = {KP_7_ALT_OVERRIDE,    NO_OVERRIDE,                     NO_OVERRIDE},
+    [KP_8_SYMBOLS]   = {KP_8_ALT_OVERRIDE,    NO_OVERRIDE,                     NO_OVERRIDE},
+    [KP_9_SYMBOLS]   = {KP_9_ALT_OVERRIDE,    NO_OVERRIDE,                     NO_OVERRIDE},
+    [BSPC_SYMBOLS]   = {NO_OVERRIDE,          NO_OVERRIDE,                     BSPC_SHIFT_OVERRIDE},
+    [KP_4_SYMBOLS]   = {KP_4_ALT_OVERRIDE,    NO_OVERRIDE,                     NO_OVERRIDE},
+    [KP_5_SYMBOLS]   = {KP_5_ALT_OVERRIDE,    NO_OVERRIDE,                     NO_OVERRIDE},
+    [KP_6_SYMBOLS]   = {KP_6_ALT_OVERRIDE,    NO_OVERRIDE,                     NO_OVERRIDE},
+    [KP_0_SYMBOLS]   = {KP_0_ALT_OVERRIDE,    NO_OVERRIDE,                     NO_OVERRIDE},
+    [KP_1_SYMBOLS]   = {KP_1_ALT_OVERRIDE,    NO_OVERRIDE,                     NO_OVERRIDE},
+    [KP_2_SYMBOLS]   = {KP_2_ALT_OVERRIDE,    NO_OVERRIDE,                     NO_OVERRIDE},
+    [KP_3_SYMBOLS]   = {KP_3_ALT_OVERRIDE,    NO_OVERRIDE,                     NO_OVERRIDE}
+};
+
+// Modifiers one of which must be held for any slot of each row to match
+static const uint8_t PROGMEM symbol_row_mods[SYMBOL_ROW_COUNT] = {
+    [Q_SYMBOLS]      = MOD_MASK_ALT,
+    [W_SYMBOLS]      = MOD_MASK_ALT,
+    [E_SYMBOLS]      = MOD_MASK_ALT,
+    [R_SYMBOLS]      = MOD_MASK_ALT,
+    [T_SYMBOLS]      = MOD_MASK_ALT,
+    [Y_SYMBOLS]      = MOD_MASK_ALT,
+    [U_SYMBOLS]      = MOD_MASK_ALT,
+    [I_SYMBOLS]      = MOD_MASK_ALT,
+    [O_SYMBOLS]      = MOD_MASK_ALT,
+    [P_SYMBOLS]      = MOD_MASK_ALT,
+    [A_SYMBOLS]      = MOD_MASK_ALT,
+    [S_SYMBOLS]      = MOD_MASK_ALT,
+    [D_SYMBOLS]      = MOD_MASK_ALT,
+    [F_SYMBOLS]      = MOD_MASK_ALT,
+    [G_SYMBOLS]      = MOD_MASK_ALT,
+    [H_SYMBOLS]      = MOD_MASK_ALT,
+    [J_SYMBOLS]      = MOD_MASK_ALT,
+    [K_SYMBOLS]      = MOD_MASK_ALT,
+    [L_SYMBOLS]      = MOD_MASK_ALT,
+    [SCLN_SYMBOLS]   = MOD_MASK_ALT,
+    [Z_SYMBOLS]      = MOD_MASK_ALT,
+    [X_SYMBOLS]      = MOD_MASK_ALT,
+    [C_SYMBOLS]      = MOD_MASK_ALT,
+    [V_SYMBOLS]      = MOD_MASK_ALT,
+    [B_SYMBOLS]      = MOD_MASK_ALT,
+    [N_SYMBOLS]      = MOD_MASK_ALT,
+    [M_SYMBOLS]      = MOD_MASK_ALT,
+    [REPEAT_SYMBOLS] = MOD_MASK_SHIFT,
+    [DOT_SYMBOLS]    = MOD_MASK_SA,
+    [SLSH_SYMBOLS]   = MOD_MASK_ALT,
+    [KP_7_SYMBOLS]   = MOD_MASK_ALT,
+    [KP_8_SYMBOLS]   = MOD_MASK_ALT,
+    [KP_9_SYMBOLS]   = MOD_MASK_ALT,
+    [BSPC_SYMBOLS]   = MOD_MASK_SHIFT,
+    [KP_4_SYMBOLS]   = MOD_MASK_ALT,
+    [KP_5_SYMBOLS]   = MOD_MASK_ALT,
+    [KP_6_SYMBOLS]   = MOD_MASK_ALT,
+    [KP_0_SYMBOLS]   = MOD_MASK_ALT,
+    [KP_1_SYMBOLS]   = MOD_MASK_ALT,
+    [KP_2_SYMBOLS]   = MOD_MASK_ALT,
+    [KP_3_SYMBOLS]   = MOD_MASK_ALT
+};
+
+// Trigger keycode -> symbol row, for basic keycodes
+static const uint8_t PROGMEM symbol_rows[] = {
+    [KC_Q] = Q_SYMBOLS,
+    [KC_W] = W_SYMBOLS,
+    [KC_E] = E_SYMBOLS,
+    [KC_R] = R_SYMBOLS,
+    [KC_T] = T_SYMBOLS,
+    [KC_Y] = Y_SYMBOLS,
+    [KC_U] = U_SYMBOLS,
+    [KC_I] = I_SYMBOLS,
+    [KC_O] = O_SYMBOLS,
+    [KC_P] = P_SYMBOLS,
+    [KC_A] = A_SYMBOLS,
+    [KC_S] = S_SYMBOLS,
+    [KC_D] = D_SYMBOLS,
+    [KC_F] = F_SYMBOLS,
+    [KC_G] = G_SYMBOLS,
+    [KC_H] = H_SYMBOLS,
+    [KC_J] = J_SYMBOLS,
+    [KC_K] = K_SYMBOLS,
+    [KC_L] = L_SYMBOLS,
+    [KC_SCLN] = SCLN_SYMBOLS,
+    [KC_Z] = Z_SYMBOLS,
+    [KC_X] = X_SYMBOLS,
+    [KC_C] = C_SYMBOLS,
+    [KC_V] = V_SYMBOLS,
+    [KC_B] = B_SYMBOLS,
+    [KC_N] = N_SYMBOLS,
+    [KC_M] = M_SYMBOLS,
+    [KC_DOT] = DOT_SYMBOLS,
+    [KC_SLSH] = SLSH_SYMBOLS,
+    [KC_KP_7] = KP_7_SYMBOLS,
+    [KC_KP_8] = KP_8_SYMBOLS,
+    [KC_KP_9] = KP_9_SYMBOLS,
+    [KC_BSPC] = BSPC_SYMBOLS,
+    [KC_KP_4] = KP_4_SYMBOLS,
+    [KC_KP_5] = KP_5_SYMBOLS,
+    [KC_KP_6] = KP_6_SYMBOLS,
+    [KC_KP_0] = KP_0_SYMBOLS,
+    [KC_KP_1] = KP_1_SYMBOLS,
+    [KC_KP_2] = KP_2_SYMBOLS,
+    [KC_KP_3] = KP_3_SYMBOLS
+};
+
+// Symbol rows of triggers outside the basic keycode range
+static uint8_t extended_symbol_row(uint16_t keycode) {
+    switch (keycode) {
+        case QK_REPEAT_KEY:
+            return REPEAT_SYMBOLS;
+        default:
+            return NO_SYMBOLS;
+    }
+}
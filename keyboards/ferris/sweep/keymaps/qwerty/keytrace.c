@@ -0,0 +1,135 @@
+#include QMK_KEYBOARD_H
+#include "keytrace.h"
+
+// Bytes in the ring buffer. A typical record is 2 bytes, so 256 bytes hold
+// over 100 events between console drains.
+#ifndef KEY_TRACE_SIZE
+#    define KEY_TRACE_SIZE 256
+#endif
+_Static_assert(KEY_TRACE_SIZE <= 32768 && (KEY_TRACE_SIZE & (KEY_TRACE_SIZE - 1)) == 0, "KEY_TRACE_SIZE must be a power of two, up to 32768");
+_Static_assert(MATRIX_ROWS * MATRIX_COLS < KEY_TRACE_DROPPED, "Matrix positions must fit in 6 bits");
+
+// Drain everything once no key has been pressed or released for this long.
+// While typing, one line is drained per housekeeping pass once the buffer is
+// half full.
+#ifndef KEY_TRACE_DRAIN_IDLE_MS
+#    define KEY_TRACE_DRAIN_IDLE_MS 100
+#endif
+
+// Whole records per console line, up to this many bytes
+#define KEY_TRACE_LINE_BYTES 16
+
+// Longest record: header, 5 byte varint, layer and mods
+#define KEY_TRACE_MAX_RECORD 8
+
+static uint8_t  key_trace[KEY_TRACE_SIZE];
+static uint16_t key_trace_head;
+static uint16_t key_trace_tail;
+static uint16_t key_trace_dropped;
+
+static uint32_t last_time;
+static uint16_t last_event;
+static uint8_t  last_layer;
+static uint8_t  last_mods;
+static bool     force_state = true;
+static uint8_t  line_sequence;
+
+static void put_byte(uint8_t value) {
+    key_trace[key_trace_head++ & (KEY_TRACE_SIZE - 1)] = value;
+}
+
+static void put_varint(uint32_t value) {
+    while (value >= 0x80) {
+        put_byte((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    put_byte(value);
+}
+
+static uint8_t get_byte(uint16_t at) {
+    return key_trace[at & (KEY_TRACE_SIZE - 1)];
+}
+
+static uint8_t record_length(uint16_t at) {
+    uint8_t header = get_byte(at);
+    uint8_t length = 1;
+    while (get_byte(at + length++) & 0x80) {
+    }
+    return (header & KEY_TRACE_STATE) ? length + 2 : length;
+}
+
+void key_trace_record(keyrecord_t *record) {
+    // Extend the 16 bit event time with the upper bits of the current time
+    uint32_t now  = timer_read32();
+    uint32_t time = (now & 0xFFFF0000) | record->event.time;
+    if (time > now) {
+        time -= 0x10000;
+    }
+    last_event = record->event.time;
+
+    uint16_t free = KEY_TRACE_SIZE - (uint16_t)(key_trace_head - key_trace_tail);
+    if (free < (key_trace_dropped ? KEY_TRACE_MAX_RECORD + 4 : KEY_TRACE_MAX_RECORD)) {
+        key_trace_dropped++;
+        return;
+    }
+    if (key_trace_dropped) {
+        put_byte(KEY_TRACE_DROPPED);
+        put_varint(key_trace_dropped);
+        key_trace_dropped = 0;
+        force_state       = true;
+    }
+
+    uint8_t layer  = get_highest_layer(layer_state | default_layer_state);
+    uint8_t mods   = get_mods() | get_oneshot_mods();
+    bool    state  = force_state || layer != last_layer || mods != last_mods;
+    uint8_t header = record->event.key.row * MATRIX_COLS + record->event.key.col;
+    if (record->event.pressed) {
+        header |= KEY_TRACE_PRESSED;
+    }
+    if (state) {
+        header |= KEY_TRACE_STATE;
+    }
+
+    put_byte(header);
+    put_varint(time - last_time);
+    if (state) {
+        put_byte(layer);
+        put_byte(mods);
+    }
+    last_time   = time;
+    last_layer  = layer;
+    last_mods   = mods;
+    force_state = false;
+}
+
+// Print one console line of whole records, so a line lost on the way to the
+// host never splits a record
+static void drain_line(void) {
+    uprintf("kt %02X ", line_sequence++);
+    uint8_t bytes = 0;
+    while (key_trace_tail != key_trace_head) {
+        uint8_t length = record_length(key_trace_tail);
+        if (bytes > 0 && bytes + length > KEY_TRACE_LINE_BYTES) {
+            break;
+        }
+        for (uint8_t i = 0; i < length; i++) {
+            uprintf("%02X", get_byte(key_trace_tail++));
+        }
+        bytes += length;
+    }
+    uprintf("\n");
+}
+
+void key_trace_task(void) {
+    if (key_trace_tail == key_trace_head) {
+        return;
+    }
+
+    if (timer_elapsed(last_event) >= KEY_TRACE_DRAIN_IDLE_MS) {
+        while (key_trace_tail != key_trace_head) {
+            drain_line();
+        }
+    } else if ((uint16_t)(key_trace_head - key_trace_tail) >= KEY_TRACE_SIZE / 2) {
+        drain_line();
+    }
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <stdint.h>
+
+// Keystroke capture (KEY_TRACE_ENABLE = yes in rules.mk)
+// Every key press and release is recorded in a compact binary format and
+// streamed over the QMK console. scripts/decode-keytrace.js turns the console
+// output back into a binary capture file and a list of events.
+//
+// Record format, one per event:
+//   byte 0   bit 7: pressed, bit 6: layer and mods follow,
+//            bits 0-5: matrix position (row * MATRIX_COLS + col)
+//   varint   milliseconds since the previous record (7 bits per byte, low first)
+//   [layer]  highest active layer, if bit 6 is set
+//   [mods]   get_mods() | get_oneshot_mods(), if bit 6 is set
+// Position 0x3F with bits 6 and 7 clear marks lost records, followed by a
+// varint count of them.
+
+#define KEY_TRACE_PRESSED 0x80
+#define KEY_TRACE_STATE 0x40
+#define KEY_TRACE_POSITION 0x3F
+#define KEY_TRACE_DROPPED KEY_TRACE_POSITION
+
+#ifdef KEY_TRACE_ENABLE
+void key_trace_record(keyrecord_t *record);
+void key_trace_task(void);
+#else
+#    define key_trace_record(record)
+#    define key_trace_task()
+#endif
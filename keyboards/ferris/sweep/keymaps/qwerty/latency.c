@@ -0,0 +1,124 @@
+#include QMK_KEYBOARD_H
+#include "latency.h"
+
+#if defined(__AVR__)
+#    include <util/atomic.h>
+#    include "timer_avr.h"
+#endif
+
+// Entries in the ring buffer. Each one is 5 bytes of RAM.
+#ifndef LATENCY_TRACE_SIZE
+#    define LATENCY_TRACE_SIZE 64
+#endif
+_Static_assert(LATENCY_TRACE_SIZE <= 128 && (LATENCY_TRACE_SIZE & (LATENCY_TRACE_SIZE - 1)) == 0, "LATENCY_TRACE_SIZE must be a power of two, up to 128");
+
+// Only print once no key has been pressed for this long, so console output
+// doesn't land in the middle of a measurement
+#ifndef LATENCY_DRAIN_IDLE_MS
+#    define LATENCY_DRAIN_IDLE_MS 250
+#endif
+
+typedef struct {
+    uint16_t time; // Microseconds, wrapping every 65 ms
+    uint16_t keycode;
+    uint8_t  event;
+} latency_entry_t;
+
+// Single producer (key processing and the report hook), single consumer
+// (latency_task()). Only the producer writes head and only the consumer writes
+// tail, so neither side needs to block the other.
+static latency_entry_t  latency_trace[LATENCY_TRACE_SIZE];
+static volatile uint8_t latency_head;
+static volatile uint8_t latency_tail;
+static uint8_t          latency_dropped;
+
+// The key press the next keyboard report belongs to
+static uint16_t pending_keycode;
+static bool     awaiting_report;
+static uint16_t last_press;
+
+static host_driver_t *host_driver;
+static host_driver_t  latency_driver;
+
+// Microsecond timestamp, as fine as the platform timer allows
+static uint16_t latency_now(void) {
+#if defined(__AVR__)
+    // timer0 interrupts once per ms, and TCNT0 counts up to TIMER_RAW_TOP in between
+    uint32_t ms;
+    uint8_t  raw;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        ms  = timer_read32();
+        raw = TIMER_RAW;
+        // A tick that arrived after interrupts were disabled hasn't been counted yet
+        if ((TIFR0 & _BV(OCF0A)) && raw < TIMER_RAW_TOP / 2) {
+            ms++;
+        }
+    }
+    return ms * 1000 + (uint32_t)raw * 1000 / TIMER_RAW_TOP;
+#elif defined(PROTOCOL_CHIBIOS)
+    return TIME_I2US(chVTGetSystemTimeX());
+#else
+    return timer_read() * 1000;
+#endif
+}
+
+void latency_mark(uint8_t event, uint16_t keycode) {
+    uint16_t now = latency_now();
+
+    switch (event & 0x0F) {
+        case LATENCY_ENTER:
+            pending_keycode = keycode;
+            awaiting_report = true;
+            last_press      = timer_read();
+            break;
+        case LATENCY_PRESS:
+            last_press = timer_read();
+            break;
+        case LATENCY_REPORT:
+            if (!awaiting_report) {
+                return;
+            }
+            awaiting_report = false;
+            keycode         = pending_keycode;
+            break;
+    }
+
+    uint8_t head = latency_head;
+    if ((uint8_t)(head - latency_tail) >= LATENCY_TRACE_SIZE) {
+        latency_dropped++;
+        return;
+    }
+    latency_trace[head & (LATENCY_TRACE_SIZE - 1)] = (latency_entry_t){.time = now, .keycode = keycode, .event = event};
+    latency_head                                   = head + 1;
+}
+
+static void latency_send_keyboard(report_keyboard_t *report) {
+    host_driver->send_keyboard(report);
+    latency_mark(LATENCY_REPORT, KC_NO);
+}
+
+void latency_task(void) {
+    // The USB driver is only set up after keyboard_post_init_user(), so hook
+    // its keyboard report here once it exists
+    host_driver_t *driver = host_get_driver();
+    if (driver != NULL && driver != &latency_driver) {
+        host_driver                  = driver;
+        latency_driver               = *driver;
+        latency_driver.send_keyboard = latency_send_keyboard;
+        host_set_driver(&latency_driver);
+    }
+
+    if (latency_tail == latency_head || timer_elapsed(last_press) < LATENCY_DRAIN_IDLE_MS) {
+        return;
+    }
+
+    if (latency_dropped > 0) {
+        uprintf("lat drop %u\n", latency_dropped);
+        latency_dropped = 0;
+    }
+    while (latency_tail != latency_head) {
+        latency_entry_t *entry = &latency_trace[latency_tail & (LATENCY_TRACE_SIZE - 1)];
+        uprintf("lat %02X %04X %04X\n", entry->event, entry->keycode, entry->time);
+        latency_tail = latency_tail + 1;
+    }
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <stdint.h>
+
+// Keystroke latency tracing (LATENCY_TRACE_ENABLE = yes in rules.mk)
+// Timestamps are taken on the hot path and drained over the QMK console
+// while the keyboard is idle. scripts/decode-latency.js turns the console
+// output into latency histograms.
+
+// Event in the low bits, flags in the high bits
+enum latency_event {
+    LATENCY_ENTER    = 0x00, // process_record_user() entry
+    LATENCY_OVERRIDE = 0x01, // symbol lookup resolved (keys without symbols have none)
+    LATENCY_EXIT     = 0x02, // process_record_user() exit
+    LATENCY_REPORT   = 0x03, // first keyboard report sent after the key press
+    LATENCY_PRESS    = 0x04, // physical key press, before the tapping engine
+    LATENCY_HIT      = 0x10, // LATENCY_OVERRIDE: a symbol matched
+};
+
+#ifdef LATENCY_TRACE_ENABLE
+void latency_mark(uint8_t event, uint16_t keycode);
+void latency_task(void);
+#else
+#    define latency_mark(event, keycode)
+#    define latency_task()
+#endif
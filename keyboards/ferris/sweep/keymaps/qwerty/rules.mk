@@ -2,3 +2,59 @@ KEY_OVERRIDE_ENABLE = yes
 REPEAT_KEY_ENABLE = yes
 CAPS_WORD_ENABLE = yes
 COMBO_ENABLE = yes
+MOUSEKEY_ENABLE = yes
+
+# Host OS and keyboard layout the symbols are typed for: macos_uk, linux_us or
+# linux_compose, each with its own keymap_tables_<profile>.h from scripts/generate-keymap.js
+# qmk compile -kb ferris/sweep -km qwerty -e OUTPUT_PROFILE=linux_compose
+OUTPUT_PROFILE ?= macos_uk
+OPT_DEFS += -DKEYMAP_TABLES=\"keymap_tables_$(strip $(OUTPUT_PROFILE)).h\"
+
+# Report a press on the first edge, and only wait out the bounce on release.
+# Each key is debounced on its own (one byte of state per key).
+# Compare against the default with -e DEBOUNCE_TYPE=sym_defer_g
+DEBOUNCE_TYPE ?= asym_eager_defer_pk
+
+# Keystroke latency tracing over the QMK console, decoded by scripts/decode-latency.js
+# qmk compile -kb ferris/sweep -km qwerty -e LATENCY_TRACE_ENABLE=yes
+LATENCY_TRACE_ENABLE ?= no
+ifeq ($(strip $(LATENCY_TRACE_ENABLE)), yes)
+    CONSOLE_ENABLE = yes
+    SRC += latency.c
+    OPT_DEFS += -DLATENCY_TRACE_ENABLE
+endif
+
+# Per-key tapping terms learned from tap and hold timings, saved to EEPROM
+# qmk compile -kb ferris/sweep -km qwerty -e ADAPTIVE_TAPPING_TERM_ENABLE=yes
+ADAPTIVE_TAPPING_TERM_ENABLE ?= no
+ifeq ($(strip $(ADAPTIVE_TAPPING_TERM_ENABLE)), yes)
+    CONSOLE_ENABLE = yes
+    SRC += tapping_term.c
+    OPT_DEFS += -DADAPTIVE_TAPPING_TERM_ENABLE
+endif
+
+# Key press and symbol override counts, saved to EEPROM and drawn by scripts/usage-heatmap.js
+# qmk compile -kb ferris/sweep -km qwerty -e USAGE_STATS_ENABLE=yes
+USAGE_STATS_ENABLE ?= no
+ifeq ($(strip $(USAGE_STATS_ENABLE)), yes)
+    CONSOLE_ENABLE = yes
+    SRC += usage.c
+    OPT_DEFS += -DUSAGE_STATS_ENABLE
+endif
+
+# Binary keystroke capture over the QMK console, decoded by scripts/decode-keytrace.js
+# qmk compile -kb ferris/sweep -km qwerty -e KEY_TRACE_ENABLE=yes
+KEY_TRACE_ENABLE ?= no
+ifeq ($(strip $(KEY_TRACE_ENABLE)), yes)
+    CONSOLE_ENABLE = yes
+    SRC += keytrace.c
+    OPT_DEFS += -DKEY_TRACE_ENABLE
+endif
+
+# Print matrix scans per second to the QMK console, e.g. to compare underglow on and off
+# qmk compile -kb ferris/sweep -km qwerty -e SCAN_RATE_ENABLE=yes -e RGBLIGHT_ENABLE=yes
+SCAN_RATE_ENABLE ?= no
+ifeq ($(strip $(SCAN_RATE_ENABLE)), yes)
+    CONSOLE_ENABLE = yes
+    OPT_DEFS += -DDEBUG_MATRIX_SCAN_RATE
+endif
@@ -0,0 +1,194 @@
+#include QMK_KEYBOARD_H
+#include "tapping_term.h"
+
+// Mod-tap keys tracked. The Sweep has four homerow mods.
+#ifndef ADAPTIVE_TAPPING_KEYS
+#    define ADAPTIVE_TAPPING_KEYS 4
+#endif
+
+// Range the learned tapping term is kept within
+#ifndef ADAPTIVE_TAPPING_TERM_MIN
+#    define ADAPTIVE_TAPPING_TERM_MIN 120
+#endif
+#ifndef ADAPTIVE_TAPPING_TERM_MAX
+#    define ADAPTIVE_TAPPING_TERM_MAX 250
+#endif
+
+// Margin above the average tap, in tenths of a standard deviation. 23 (2.3σ)
+// lets roughly 1 tap in 100 run past the term and misfire as a hold.
+#ifndef ADAPTIVE_TAPPING_TERM_SIGMA
+#    define ADAPTIVE_TAPPING_TERM_SIGMA 23
+#endif
+
+// Taps seen before the learned term replaces TAPPING_TERM
+#ifndef ADAPTIVE_TAPPING_MIN_TAPS
+#    define ADAPTIVE_TAPPING_MIN_TAPS 32
+#endif
+
+// Save once the keyboard has been idle this long, and at most this often, to
+// spare the EEPROM (or its flash emulation)
+#ifndef ADAPTIVE_TAPPING_SAVE_IDLE_MS
+#    define ADAPTIVE_TAPPING_SAVE_IDLE_MS 30000
+#endif
+#ifndef ADAPTIVE_TAPPING_SAVE_INTERVAL_MS
+#    define ADAPTIVE_TAPPING_SAVE_INTERVAL_MS 600000
+#endif
+
+// Bump when the saved layout changes, so old data is discarded
+#define ADAPTIVE_TAPPING_VERSION 1
+
+// Running averages use weight 1/16 for each new sample. Means are stored in
+// 1/16 ms so the small steps aren't lost to rounding.
+#define EWMA_SHIFT 4
+
+typedef struct {
+    uint16_t mean; // 1/16 ms
+    uint16_t var;  // ms², saturating
+    uint8_t  count;
+} duration_stats_t;
+
+typedef struct {
+    keypos_t         key;
+    duration_stats_t tap;
+    duration_stats_t hold;
+} key_stats_t;
+
+typedef struct {
+    uint8_t     version;
+    uint8_t     keys;
+    key_stats_t stats[ADAPTIVE_TAPPING_KEYS];
+} adaptive_tapping_t;
+_Static_assert(sizeof(adaptive_tapping_t) <= ADAPTIVE_TAPPING_DATA_SIZE, "ADAPTIVE_TAPPING_DATA_SIZE is too small for the learned tapping terms");
+
+static adaptive_tapping_t learned;
+static uint16_t           tapping_terms[ADAPTIVE_TAPPING_KEYS];
+static uint16_t           pressed_at[ADAPTIVE_TAPPING_KEYS];
+
+static bool     dirty;
+static uint32_t last_event;
+static uint32_t last_save;
+
+static uint8_t isqrt(uint16_t value) {
+    uint8_t root = 0;
+    for (uint8_t bit = 0x80; bit; bit >>= 1) {
+        uint8_t trial = root | bit;
+        if ((uint16_t)trial * trial <= value) {
+            root = trial;
+        }
+    }
+    return root;
+}
+
+// Shortest term that lets all but ADAPTIVE_TAPPING_TERM_SIGMA's worth of taps
+// through. If holds are released sooner than that, the distributions overlap
+// and the term splits the difference.
+static uint16_t derive_tapping_term(const key_stats_t *stats) {
+    if (stats->tap.count < ADAPTIVE_TAPPING_MIN_TAPS) {
+        return TAPPING_TERM;
+    }
+
+    int16_t term = (stats->tap.mean >> EWMA_SHIFT) + isqrt(stats->tap.var) * ADAPTIVE_TAPPING_TERM_SIGMA / 10;
+    if (stats->hold.count >= ADAPTIVE_TAPPING_MIN_TAPS) {
+        int16_t hold_bound = (stats->hold.mean >> EWMA_SHIFT) - isqrt(stats->hold.var) * ADAPTIVE_TAPPING_TERM_SIGMA / 10;
+        if (hold_bound < term) {
+            term = (term + hold_bound) / 2;
+        }
+    }
+
+    if (term < ADAPTIVE_TAPPING_TERM_MIN) {
+        return ADAPTIVE_TAPPING_TERM_MIN;
+    }
+    if (term > ADAPTIVE_TAPPING_TERM_MAX) {
+        return ADAPTIVE_TAPPING_TERM_MAX;
+    }
+    return term;
+}
+
+static void update_stats(duration_stats_t *stats, uint16_t duration) {
+    // Long holds say nothing about where taps end, and would swamp the average
+    if (duration > ADAPTIVE_TAPPING_TERM_MAX * 2) {
+        duration = ADAPTIVE_TAPPING_TERM_MAX * 2;
+    }
+
+    if (stats->count == 0) {
+        stats->mean = duration << EWMA_SHIFT;
+        stats->var  = 0;
+    } else {
+        int16_t  delta    = (int16_t)(duration << EWMA_SHIFT) - (int16_t)stats->mean;
+        int16_t  distance = delta >> EWMA_SHIFT;
+        uint32_t square   = (uint32_t)((int32_t)distance * distance);
+        int32_t  var      = stats->var + ((int32_t)(square > UINT16_MAX ? UINT16_MAX : square) - stats->var) / (1 << EWMA_SHIFT);
+
+        stats->mean += delta / (1 << EWMA_SHIFT);
+        stats->var = var;
+    }
+    if (stats->count < UINT8_MAX) {
+        stats->count++;
+    }
+}
+
+static int8_t find_key(keypos_t key, bool add) {
+    for (uint8_t i = 0; i < learned.keys; i++) {
+        if (KEYEQ(learned.stats[i].key, key)) {
+            return i;
+        }
+    }
+    if (!add || learned.keys == ADAPTIVE_TAPPING_KEYS) {
+        return -1;
+    }
+
+    learned.stats[learned.keys] = (key_stats_t){.key = key};
+    tapping_terms[learned.keys] = TAPPING_TERM;
+    return learned.keys++;
+}
+
+void adaptive_tapping_init(void) {
+    eeconfig_read_user_datablock(&learned, 0, sizeof(learned));
+    if (learned.version != ADAPTIVE_TAPPING_VERSION || learned.keys > ADAPTIVE_TAPPING_KEYS) {
+        learned = (adaptive_tapping_t){.version = ADAPTIVE_TAPPING_VERSION};
+    }
+    for (uint8_t i = 0; i < learned.keys; i++) {
+        tapping_terms[i] = derive_tapping_term(&learned.stats[i]);
+    }
+}
+
+void adaptive_tapping_record(uint16_t keycode, keyrecord_t *record) {
+    last_event = timer_read32();
+    if (!IS_QK_MOD_TAP(keycode)) {
+        return;
+    }
+
+    int8_t i = find_key(record->event.key, record->event.pressed);
+    if (i < 0) {
+        return;
+    }
+    if (record->event.pressed) {
+        pressed_at[i] = record->event.time;
+        return;
+    }
+
+    uint16_t duration = TIMER_DIFF_16(record->event.time, pressed_at[i]);
+    update_stats(record->tap.count > 0 ? &learned.stats[i].tap : &learned.stats[i].hold, duration);
+    tapping_terms[i] = derive_tapping_term(&learned.stats[i]);
+    dirty            = true;
+}
+
+uint16_t get_tapping_term(uint16_t keycode, keyrecord_t *record) {
+    int8_t i = find_key(record->event.key, false);
+    return i < 0 ? TAPPING_TERM : tapping_terms[i];
+}
+
+void adaptive_tapping_task(void) {
+    if (!dirty || timer_elapsed32(last_event) < ADAPTIVE_TAPPING_SAVE_IDLE_MS || (last_save != 0 && timer_elapsed32(last_save) < ADAPTIVE_TAPPING_SAVE_INTERVAL_MS)) {
+        return;
+    }
+
+    eeconfig_update_user_datablock(&learned, 0, sizeof(learned));
+    dirty     = false;
+    last_save = timer_read32();
+
+    for (uint8_t i = 0; i < learned.keys; i++) {
+        const key_stats_t *stats = &learned.stats[i];
+        uprintf("tapping term %u,%u: %ums (tap %u+-%ums n=%u, hold %u+-%ums n=%u)\n", stats->key.row, stats->key.col, tapping_terms[i], stats->tap.mean >> EWMA_SHIFT, isqrt(stats->tap.var), stats->tap.count, stats->hold.mean >> EWMA_SHIFT, isqrt(stats->hold.var), stats->hold.count);
+    }
+}
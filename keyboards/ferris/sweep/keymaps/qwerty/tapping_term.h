@@ -0,0 +1,19 @@
+#pragma once
+
+#include <stdint.h>
+
+// Adaptive per-key tapping term (ADAPTIVE_TAPPING_TERM_ENABLE = yes in rules.mk)
+// Tap and hold durations of each mod-tap key are tracked as running averages,
+// and get_tapping_term() uses them to pick the shortest term that still keeps
+// taps from turning into holds. The learned values are saved to EEPROM and
+// printed to the QMK console whenever they're saved.
+
+#ifdef ADAPTIVE_TAPPING_TERM_ENABLE
+void adaptive_tapping_init(void);
+void adaptive_tapping_record(uint16_t keycode, keyrecord_t *record);
+void adaptive_tapping_task(void);
+#else
+#    define adaptive_tapping_init()
+#    define adaptive_tapping_record(keycode, record)
+#    define adaptive_tapping_task()
+#endif
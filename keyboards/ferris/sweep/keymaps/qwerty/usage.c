@@ -0,0 +1,136 @@
+#include QMK_KEYBOARD_H
+#include "usage.h"
+
+// Counters for each key on each layer, then for each override
+#define USAGE_STATS_KEYS (USAGE_STATS_LAYERS * MATRIX_ROWS * MATRIX_COLS)
+#define USAGE_STATS_COUNTERS (USAGE_STATS_KEYS + USAGE_STATS_OVERRIDES)
+
+// Totals follow the learned tapping terms in the user datablock (see
+// config.h), after a version byte
+#define USAGE_STATS_OFFSET ADAPTIVE_TAPPING_DATA_SIZE
+_Static_assert(1 + USAGE_STATS_COUNTERS * sizeof(uint16_t) <= USAGE_STATS_DATA_SIZE, "USAGE_STATS_DATA_SIZE is too small for the usage totals");
+
+// Bump when the counters change meaning (e.g. layers are reordered), so old
+// totals are discarded
+#define USAGE_STATS_VERSION 1
+
+// Save once the keyboard has been idle this long, and at most this often, to
+// spare the EEPROM (or its flash emulation)
+#ifndef USAGE_STATS_SAVE_IDLE_MS
+#    define USAGE_STATS_SAVE_IDLE_MS 5000
+#endif
+#ifndef USAGE_STATS_SAVE_INTERVAL_MS
+#    define USAGE_STATS_SAVE_INTERVAL_MS 600000
+#endif
+
+// Save sooner once a key has been pressed this many times, so counts in RAM
+// are written out before they saturate
+#define USAGE_STATS_SAVE_COUNT 128
+
+// Counts since the last save. A byte each keeps the hot path to an increment.
+static uint8_t pending[USAGE_STATS_COUNTERS];
+
+static bool     dirty;  // counts are waiting to be saved
+static bool     full;   // a count has reached USAGE_STATS_SAVE_COUNT
+static bool     reset;  // the EEPROM holds no totals (or old ones) yet
+static bool     saving; // a save is part way through
+static uint16_t cursor; // next counter to save
+static uint32_t last_event;
+static uint32_t last_save;
+
+static void count(uint16_t counter) {
+    if (pending[counter] < UINT8_MAX) {
+        pending[counter]++;
+    }
+    if (pending[counter] >= USAGE_STATS_SAVE_COUNT) {
+        full = true;
+    }
+    dirty = true;
+}
+
+void usage_stats_init(void) {
+    uint8_t version;
+    eeconfig_read_user_datablock(&version, USAGE_STATS_OFFSET, sizeof(version));
+    if (version != USAGE_STATS_VERSION) {
+        reset = true;
+        dirty = true;
+    }
+}
+
+void usage_stats_key(keyrecord_t *record) {
+    last_event = timer_read32();
+    if (!record->event.pressed || record->event.key.row >= MATRIX_ROWS || record->event.key.col >= MATRIX_COLS) {
+        return;
+    }
+
+    uint8_t layer = get_highest_layer(layer_state | default_layer_state);
+    if (layer < USAGE_STATS_LAYERS) {
+        count(((uint16_t)layer * MATRIX_ROWS + record->event.key.row) * MATRIX_COLS + record->event.key.col);
+    }
+}
+
+void usage_stats_override(uint8_t override) {
+    if (override < USAGE_STATS_OVERRIDES) {
+        count(USAGE_STATS_KEYS + override);
+    }
+}
+
+// Add one counter's pending count to its total, writing only if it changed
+// (and only the bytes that changed, as eeconfig_update_user_datablock() skips
+// the rest), then print the total
+static void save_counter(uint16_t counter) {
+    uint32_t offset = USAGE_STATS_OFFSET + 1 + counter * sizeof(uint16_t);
+    uint16_t total  = 0;
+    if (!reset) {
+        eeconfig_read_user_datablock(&total, offset, sizeof(total));
+    }
+    if (pending[counter] > 0 || reset) {
+        total            = total > UINT16_MAX - pending[counter] ? UINT16_MAX : total + pending[counter];
+        pending[counter] = 0;
+        eeconfig_update_user_datablock(&total, offset, sizeof(total));
+    }
+
+    if (total == 0) {
+        return;
+    }
+    if (counter < USAGE_STATS_KEYS) {
+        uint8_t key = counter % (MATRIX_ROWS * MATRIX_COLS);
+        uprintf("usage k %u %u %u %u\n", counter / (MATRIX_ROWS * MATRIX_COLS), key / MATRIX_COLS, key % MATRIX_COLS, total);
+    } else {
+        uprintf("usage o %u %u\n", counter - USAGE_STATS_KEYS, total);
+    }
+}
+
+// Saves one counter per housekeeping pass, and only while the keyboard is
+// idle, so a key press waits for at most one EEPROM write. A save interrupted
+// by typing carries on where it left off.
+void usage_stats_task(void) {
+    if (timer_elapsed32(last_event) < USAGE_STATS_SAVE_IDLE_MS) {
+        return;
+    }
+
+    if (!saving) {
+        if (!dirty || (!full && last_save != 0 && timer_elapsed32(last_save) < USAGE_STATS_SAVE_INTERVAL_MS)) {
+            return;
+        }
+        saving = true;
+        cursor = 0;
+        dirty  = false;
+        full   = false;
+        uprintf("usage start\n");
+    }
+
+    save_counter(cursor++);
+    if (cursor < USAGE_STATS_COUNTERS) {
+        return;
+    }
+
+    if (reset) {
+        uint8_t version = USAGE_STATS_VERSION;
+        eeconfig_update_user_datablock(&version, USAGE_STATS_OFFSET, sizeof(version));
+        reset = false;
+    }
+    saving    = false;
+    last_save = timer_read32();
+    uprintf("usage end\n");
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <stdint.h>
+
+// Key usage counters (USAGE_STATS_ENABLE = yes in rules.mk)
+// Presses are counted for each matrix position on each layer, and hits for
+// each symbol override. Counts build up in RAM and are added to saturating
+// 16 bit totals in the EEPROM user datablock while the keyboard is idle. Each
+// save prints the totals to the QMK console, and scripts/usage-heatmap.js
+// turns them into a heatmap of layout.yaml.
+//
+// Console output of one save:
+//   usage start
+//   usage k <layer> <row> <col> <total>   for each key pressed at least once
+//   usage o <override> <total>            for each override hit at least once
+//   usage end
+
+// Layers and overrides counted, checked against keymap_tables.h in keymap.c
+#ifndef USAGE_STATS_LAYERS
+#    define USAGE_STATS_LAYERS 4
+#endif
+#ifndef USAGE_STATS_OVERRIDES
+#    define USAGE_STATS_OVERRIDES 64
+#endif
+
+#ifdef USAGE_STATS_ENABLE
+void usage_stats_init(void);
+void usage_stats_key(keyrecord_t *record);
+void usage_stats_override(uint8_t override);
+void usage_stats_task(void);
+#else
+#    define usage_stats_init()
+#    define usage_stats_key(record)
+#    define usage_stats_override(override)
+#    define usage_stats_task()
+#endif
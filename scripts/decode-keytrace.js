@@ -0,0 +1,229 @@
+#!/usr/bin/env node
+
+/**
+ * Decode a binary keystroke capture
+ *
+ * Build the keymap with KEY_TRACE_ENABLE=yes, capture the console and decode
+ * it:
+ *
+ *   qmk compile -kb ferris/sweep -km qwerty -e KEY_TRACE_ENABLE=yes
+ *   qmk console > session.txt
+ *   node scripts/decode-keytrace.js session.txt --save session.ktr
+ *   node scripts/decode-keytrace.js session.ktr --json > session.json
+ *   node scripts/decode-keytrace.js session.ktr --trace > session.trace
+ *
+ * Console lines are "kt <sequence> <records>" in hex. The record format is
+ * described in keytrace.h. --save writes the records as a binary file, and
+ * --json writes the events with times relative to the first one, so the same
+ * session can be fed to different configurations. --trace writes them in the
+ * trace format tests/host/keysim replays, one "<time> <row> <col> <d|u>" per line.
+ */
+
+const fs = require('fs');
+const path = require('path');
+const { MATRIX_LAYOUTS, classifyLayer } = require('./generate-keymap');
+
+// Try to require js-yaml from website/node_modules when run from website/
+let yaml;
+try {
+  yaml = require('js-yaml');
+} catch (error) {
+  // If not found, try from website/node_modules (when run from root)
+  const yamlPath = path.join(__dirname, '..', 'website', 'node_modules', 'js-yaml');
+  yaml = require(yamlPath);
+}
+
+// Record header bits, as in keytrace.h
+const KEY_TRACE_PRESSED = 0x80;
+const KEY_TRACE_STATE = 0x40;
+const KEY_TRACE_POSITION = 0x3F;
+const KEY_TRACE_DROPPED = KEY_TRACE_POSITION;
+
+const MOD_NAMES = ['LCtrl', 'LShift', 'LAlt', 'LGui', 'RCtrl', 'RShift', 'RAlt', 'RGui'];
+
+/**
+ * Collect the binary records from console output
+ * Each line holds whole records, so a missing line loses only its own
+ * events. Times after a gap are shifted by the deltas that were lost.
+ */
+function parseConsole(text) {
+  const chunks = [];
+  let gaps = 0;
+  let expected = null;
+
+  for (const line of text.split('\n')) {
+    const match = line.match(/kt ([0-9A-Fa-f]{2}) ([0-9A-Fa-f]*)/);
+    if (!match) {
+      continue;
+    }
+    const sequence = parseInt(match[1], 16);
+    if (expected !== null && sequence !== expected) {
+      gaps++;
+    }
+    expected = (sequence + 1) & 0xFF;
+    chunks.push(Buffer.from(match[2], 'hex'));
+  }
+
+  return { data: Buffer.concat(chunks), gaps };
+}
+
+/**
+ * Decode binary records into events
+ */
+function decodeRecords(data) {
+  const events = [];
+  let dropped = 0;
+  let time = 0;
+  let layer = 0;
+  let mods = 0;
+  let offset = 0;
+
+  const varint = () => {
+    let value = 0;
+    let shift = 0;
+    let byte;
+    do {
+      if (offset >= data.length) {
+        throw new Error('Capture ends in the middle of a record');
+      }
+      byte = data[offset++];
+      value += (byte & 0x7F) * 2 ** shift;
+      shift += 7;
+    } while (byte & 0x80);
+    return value;
+  };
+
+  while (offset < data.length) {
+    const header = data[offset++];
+    if ((header & ~KEY_TRACE_POSITION) === 0 && (header & KEY_TRACE_POSITION) === KEY_TRACE_DROPPED) {
+      dropped += varint();
+      continue;
+    }
+
+    time += varint();
+    if (header & KEY_TRACE_STATE) {
+      layer = data[offset++];
+      mods = data[offset++];
+    }
+    events.push({
+      time,
+      matrix: header & KEY_TRACE_POSITION,
+      pressed: Boolean(header & KEY_TRACE_PRESSED),
+      layer,
+      mods
+    });
+  }
+
+  // The first delta is the time since the keyboard started
+  const start = events.length > 0 ? events[0].time : 0;
+  events.forEach(event => { event.time -= start; });
+  return { events, dropped };
+}
+
+/**
+ * Label events with their key and layer from layout.yaml
+ */
+function labelEvents(events, layoutPath) {
+  const layout = yaml.load(fs.readFileSync(layoutPath, 'utf8'));
+  const matrix = MATRIX_LAYOUTS[layout.layout.layout_name];
+  if (!matrix) {
+    throw new Error(`Unknown matrix for ${layout.layout.layout_name}`);
+  }
+
+  // Real layers are numbered in layout.yaml order, as in the generated tables
+  const layers = Object.keys(layout.layers).filter(name => classifyLayer(name).real);
+  for (const event of events) {
+    const row = Math.floor(event.matrix / matrix.cols);
+    const col = event.matrix % matrix.cols;
+    const position = matrix.position(row, col);
+    const layerName = layers[event.layer];
+    const keyDef = layerName ? layout.layers[layerName].flat()[position] : undefined;
+
+    event.row = row;
+    event.col = col;
+    event.position = position;
+    event.layerName = layerName || String(event.layer);
+    event.label = keyDef && typeof keyDef === 'object' ? keyDef.t : keyDef;
+  }
+  return events;
+}
+
+/**
+ * Names of the modifiers in a get_mods() bitmask
+ */
+function modNames(mods) {
+  return MOD_NAMES.filter((name, bit) => mods & (1 << bit)).join('+');
+}
+
+/**
+ * Main function
+ */
+function main() {
+  const args = process.argv.slice(2);
+  const option = (name, fallback) => {
+    const idx = args.indexOf(name);
+    return idx === -1 ? fallback : args.splice(idx, 2)[1];
+  };
+  const flag = name => {
+    const idx = args.indexOf(name);
+    if (idx === -1) {
+      return false;
+    }
+    args.splice(idx, 1);
+    return true;
+  };
+  const savePath = option('--save', null);
+  const layoutPath = option('--layout', path.join(__dirname, '..', 'keyboards', 'ferris', 'sweep', 'keymaps', 'qwerty', 'layout.yaml'));
+  const json = flag('--json');
+  const trace = flag('--trace');
+
+  if (!args[0]) {
+    console.error('Usage: decode-keytrace.js <console output or .ktr file> [--save file.ktr] [--json | --trace] [--layout layout.yaml]');
+    process.exit(1);
+  }
+
+  let data;
+  let gaps = 0;
+  if (args[0].endsWith('.ktr')) {
+    data = fs.readFileSync(args[0]);
+  } else {
+    ({ data, gaps } = parseConsole(fs.readFileSync(args[0], 'utf8')));
+  }
+  if (data.length === 0) {
+    console.error('No keystroke capture found. Was the keymap built with KEY_TRACE_ENABLE=yes?');
+    process.exit(1);
+  }
+
+  if (savePath) {
+    fs.writeFileSync(savePath, data);
+  }
+
+  const { events, dropped } = decodeRecords(data);
+  labelEvents(events, layoutPath);
+
+  if (json) {
+    console.log(JSON.stringify(events.map(({ time, row, col, pressed, layer, mods }) => ({ time, row, col, pressed, layer, mods })), null, 2));
+    return;
+  }
+  if (trace) {
+    console.log(events.map(({ time, row, col, pressed }) => `${time} ${row} ${col} ${pressed ? 'd' : 'u'}`).join('\n'));
+    return;
+  }
+
+  const duration = events.length > 0 ? events[events.length - 1].time : 0;
+  for (const event of events) {
+    const mods = modNames(event.mods);
+    console.log(`${String(event.time).padStart(9)}ms  ${event.pressed ? 'down' : 'up  '}  ${String(event.label ?? '').padEnd(10)} ${event.layerName}${mods ? ` ${mods}` : ''}`);
+  }
+  console.error(`\n${events.length} events over ${(duration / 1000).toFixed(1)}s in ${data.length} bytes (${(data.length / Math.max(1, events.length)).toFixed(2)} bytes/event)`);
+  if (dropped || gaps) {
+    console.error(`${dropped} events dropped on the keyboard, ${gaps} console lines missing`);
+  }
+}
+
+// Run if executed directly
+if (require.main === module) {
+  main();
+}
+
+module.exports = { parseConsole, decodeRecords, labelEvents };
@@ -0,0 +1,227 @@
+#!/usr/bin/env node
+
+/**
+ * Decode a keystroke latency trace into latency histograms
+ *
+ * Build the keymap with LATENCY_TRACE_ENABLE=yes, capture the console and
+ * decode it:
+ *
+ *   qmk compile -kb ferris/sweep -km qwerty -e LATENCY_TRACE_ENABLE=yes
+ *   qmk console > trace.txt
+ *   node scripts/decode-latency.js trace.txt [--bucket 20] [--metric user|report|press]
+ *
+ * Each trace line is "lat <event> <keycode> <time>" in hex (see latency.h).
+ */
+
+const fs = require('fs');
+
+// Event types and flags, as in latency.h
+const LATENCY_ENTER = 0x00;
+const LATENCY_OVERRIDE = 0x01;
+const LATENCY_EXIT = 0x02;
+const LATENCY_REPORT = 0x03;
+const LATENCY_PRESS = 0x04;
+const LATENCY_HIT = 0x10;
+
+// Reports more than this long after a key press belong to something else
+const MAX_REPORT_DELAY_US = 50000;
+
+const BASIC_KEYCODE_NAMES = {
+  0x28: 'Enter', 0x29: 'Esc', 0x2A: 'BSpace', 0x2B: 'Tab', 0x2C: 'Space',
+  0x2D: '-', 0x2E: '=', 0x2F: '[', 0x30: ']', 0x31: '\\', 0x33: ';',
+  0x34: "'", 0x35: '`', 0x36: ',', 0x37: '.', 0x38: '/',
+  0x4F: 'Right', 0x50: 'Left', 0x51: 'Down', 0x52: 'Up'
+};
+
+/**
+ * Human readable name for a keycode
+ */
+function keycodeName(keycode) {
+  if (keycode >= 0x2000 && keycode <= 0x3FFF) {
+    return `MT(${keycodeName(keycode & 0xFF)})`;
+  }
+  if (keycode >= 0x04 && keycode <= 0x1D) {
+    return String.fromCharCode(0x61 + keycode - 0x04);
+  }
+  if (keycode >= 0x1E && keycode <= 0x27) {
+    return String((keycode - 0x1D) % 10);
+  }
+  if (keycode >= 0x59 && keycode <= 0x62) {
+    return `KP_${(keycode - 0x58) % 10}`;
+  }
+  if (keycode === 0x7C79) {
+    return 'Repeat';
+  }
+  return BASIC_KEYCODE_NAMES[keycode] || `0x${keycode.toString(16).padStart(4, '0')}`;
+}
+
+/**
+ * Parse trace lines into one sample per key press
+ * Timestamps wrap every 65 ms, so deltas are taken modulo 2^16. A press-to-report
+ * time longer than that (a mod-tap held past 65 ms) can't be told apart from a
+ * short one, so MAX_REPORT_DELAY_US keeps the comparison to fast typing.
+ */
+function parseTrace(text) {
+  const samples = [];
+  let dropped = 0;
+  let current = null;
+  // Physical presses waiting for the tapping engine to hand them on
+  const presses = new Map();
+
+  for (const line of text.split('\n')) {
+    const drop = line.match(/lat drop (\d+)/);
+    if (drop) {
+      dropped += Number(drop[1]);
+      current = null;
+      presses.clear();
+      continue;
+    }
+
+    const match = line.match(/lat ([0-9A-Fa-f]{2}) ([0-9A-Fa-f]{4}) ([0-9A-Fa-f]{4})/);
+    if (!match) {
+      continue;
+    }
+    const event = parseInt(match[1], 16);
+    const keycode = parseInt(match[2], 16);
+    const time = parseInt(match[3], 16);
+
+    switch (event & 0x0F) {
+      case LATENCY_PRESS:
+        presses.set(keycode, time);
+        break;
+      case LATENCY_ENTER:
+        current = { keycode, enter: time, path: 'no symbols' };
+        if (presses.has(keycode)) {
+          current.press = presses.get(keycode);
+          presses.delete(keycode);
+        }
+        samples.push(current);
+        break;
+      case LATENCY_OVERRIDE:
+        if (current && current.keycode === keycode) {
+          current.path = event & LATENCY_HIT ? 'override hit' : 'override miss';
+        }
+        break;
+      case LATENCY_EXIT:
+        if (current && current.keycode === keycode) {
+          current.user = (time - current.enter) & 0xFFFF;
+        }
+        break;
+      case LATENCY_REPORT:
+        if (current && current.keycode === keycode) {
+          const delay = (time - current.enter) & 0xFFFF;
+          if (delay <= MAX_REPORT_DELAY_US) {
+            current.report = delay;
+            if (current.press !== undefined) {
+              current.total = (time - current.press) & 0xFFFF;
+            }
+          }
+        }
+        break;
+    }
+  }
+
+  return { samples, dropped };
+}
+
+/**
+ * Percentile of a sorted array
+ */
+function percentile(sorted, p) {
+  return sorted[Math.min(sorted.length - 1, Math.floor(sorted.length * p))];
+}
+
+/**
+ * Summary line: count, median, p90 and max
+ */
+function summarize(values) {
+  const sorted = [...values].sort((a, b) => a - b);
+  return `n=${String(sorted.length).padStart(4)}  median ${String(percentile(sorted, 0.5)).padStart(5)}µs  p90 ${String(percentile(sorted, 0.9)).padStart(5)}µs  max ${String(sorted[sorted.length - 1]).padStart(5)}µs`;
+}
+
+/**
+ * Text histogram with fixed-width buckets
+ */
+function histogram(values, bucket) {
+  const counts = new Map();
+  for (const value of values) {
+    const start = Math.floor(value / bucket) * bucket;
+    counts.set(start, (counts.get(start) || 0) + 1);
+  }
+  const most = Math.max(...counts.values());
+  return Array.from(counts.keys()).sort((a, b) => a - b).map(start => {
+    const count = counts.get(start);
+    const bar = '#'.repeat(Math.max(1, Math.round(count / most * 40)));
+    return `    ${String(start).padStart(6)}-${String(start + bucket - 1).padEnd(6)}µs ${bar} ${count}`;
+  });
+}
+
+/**
+ * Group samples by a key function, keeping only those with the metric
+ */
+function groupBy(samples, metric, keyFn) {
+  const groups = new Map();
+  for (const sample of samples) {
+    if (sample[metric] === undefined) {
+      continue;
+    }
+    const key = keyFn(sample);
+    if (!groups.has(key)) {
+      groups.set(key, []);
+    }
+    groups.get(key).push(sample[metric]);
+  }
+  return groups;
+}
+
+/**
+ * Main function
+ */
+function main() {
+  const args = process.argv.slice(2);
+  const option = (name, fallback) => {
+    const idx = args.indexOf(name);
+    return idx === -1 ? fallback : args.splice(idx, 2)[1];
+  };
+  const bucket = Number(option('--bucket', 20));
+  const metrics = {
+    user: { field: 'user', title: 'process_record_user() time' },
+    report: { field: 'report', title: 'process_record_user() to HID report' },
+    press: { field: 'total', title: 'Physical key press to HID report (includes tap-hold decisions)' }
+  };
+  const metric = metrics[option('--metric', 'user')];
+  if (!metric) {
+    console.error('--metric must be "user", "report" or "press"');
+    process.exit(1);
+  }
+
+  const text = fs.readFileSync(args[0] || 0, 'utf8');
+  const { samples, dropped } = parseTrace(text);
+  if (samples.length === 0) {
+    console.error('No latency trace found. Was the keymap built with LATENCY_TRACE_ENABLE=yes?');
+    process.exit(1);
+  }
+
+  console.log(`${metric.title}: ${samples.length} key presses${dropped ? `, ${dropped} events dropped` : ''}\n`);
+
+  const kind = sample => (sample.keycode >= 0x2000 && sample.keycode <= 0x3FFF ? 'mod-tap' : 'plain');
+
+  console.log('By key type and symbol lookup:');
+  for (const [group, values] of groupBy(samples, metric.field, sample => `${kind(sample)}, ${sample.path}`)) {
+    console.log(`  ${group.padEnd(26)} ${summarize(values)}`);
+  }
+
+  console.log('\nBy keycode:');
+  const byKeycode = groupBy(samples, metric.field, sample => `${keycodeName(sample.keycode)} (${kind(sample)}, ${sample.path})`);
+  for (const [group, values] of Array.from(byKeycode.entries()).sort(([a], [b]) => a.localeCompare(b))) {
+    console.log(`  ${group}  ${summarize(values)}`);
+    histogram(values, bucket).forEach(line => console.log(line));
+  }
+}
+
+// Run if executed directly
+if (require.main === module) {
+  main();
+}
+
+module.exports = { parseTrace, keycodeName };
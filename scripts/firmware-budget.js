@@ -0,0 +1,190 @@
+#!/usr/bin/env node
+
+const fs = require('fs');
+const path = require('path');
+const { execFileSync } = require('child_process');
+
+const BUDGET_FILE = 'size-budget.json';
+
+// Tables the keymap owns, reported on their own so their cost is visible
+const TABLE_SYMBOLS = /^(keymaps|key_overrides|symbol_overrides|symbol_table|symbol_rows|symbol_row_mods|symbol_cache|compose_sequences|key_combos|combo_rules|__compound_literal\.\d+)$/;
+
+/**
+ * Find qmk_firmware, the same way the userspace Makefile does
+ */
+function findQmkHome() {
+  if (process.env.QMK_HOME) {
+    return process.env.QMK_HOME;
+  }
+  try {
+    const output = execFileSync('qmk', ['config', '-ro', 'user.qmk_home'], { encoding: 'utf8' });
+    const home = output.trim().split('=')[1];
+    return home && home !== 'None' ? home : null;
+  } catch (error) {
+    return null;
+  }
+}
+
+/**
+ * A build target and the name QMK gives its ELF: the TARGET it was built with,
+ * or keyboard_keymap
+ */
+function buildTarget(keyboard, keymap, env = {}) {
+  return { keyboard, keymap, elfName: env.TARGET || `${keyboard.replace(/\//g, '_')}_${keymap}` };
+}
+
+/**
+ * Build targets to check: keyboard:keymap arguments, with the TARGET make was
+ * given, or qmk.json's build_targets with their own environment
+ */
+function findTargets(rootDir, args) {
+  const targets = args.filter(arg => arg.includes(':')).map(arg => {
+    const [keyboard, keymap] = arg.split(':');
+    return buildTarget(keyboard, keymap, process.env);
+  });
+  if (targets.length > 0 || args.length > 0) {
+    return targets;
+  }
+
+  const qmkJson = JSON.parse(fs.readFileSync(path.join(rootDir, 'qmk.json'), 'utf8'));
+  return qmkJson.build_targets.map(([keyboard, keymap, env]) => buildTarget(keyboard, keymap, env));
+}
+
+/**
+ * Pick the binutils prefix from the ELF machine type
+ */
+function toolPrefix(elfPath) {
+  const header = Buffer.alloc(20);
+  const fd = fs.openSync(elfPath, 'r');
+  fs.readSync(fd, header, 0, header.length, 0);
+  fs.closeSync(fd);
+
+  const machine = header.readUInt16LE(18);
+  if (machine === 0x53) return 'avr-';
+  if (machine === 0x28) return 'arm-none-eabi-';
+  return '';
+}
+
+/**
+ * Read section sizes and work out flash and RAM usage
+ * Sections loaded at a RAM address (0x800000+ on AVR, 0x20000000+ on ARM)
+ * count against RAM. .data counts against both: its initial values are
+ * stored in flash and copied to RAM at startup.
+ */
+function readSections(elfPath, prefix) {
+  const output = execFileSync(`${prefix}size`, ['-A', elfPath], { encoding: 'utf8' });
+  const ramStart = prefix === 'avr-' ? 0x800000 : 0x20000000;
+
+  const sections = [];
+  for (const line of output.split('\n')) {
+    const match = line.match(/^(\.\S+)\s+(\d+)\s+(\d+)/);
+    if (!match || Number(match[2]) === 0) {
+      continue;
+    }
+    const [, name, size, address] = match;
+    if (name.startsWith('.debug') || name.startsWith('.comment') || name.startsWith('.note') || name === '.stab' || name === '.stabstr') {
+      continue;
+    }
+    const inRam = Number(address) >= ramStart && Number(address) < 0x40000000;
+    sections.push({
+      name,
+      size: Number(size),
+      flash: !inRam || name === '.data',
+      ram: inRam
+    });
+  }
+  return sections;
+}
+
+/**
+ * Sizes of the keymap's own tables
+ */
+function readTables(elfPath, prefix) {
+  const output = execFileSync(`${prefix}nm`, ['-S', '--size-sort', elfPath], { encoding: 'utf8' });
+
+  const tables = new Map();
+  for (const line of output.split('\n')) {
+    const match = line.trim().match(/^[0-9a-f]+\s+([0-9a-f]+)\s+\w\s+(\S+)$/i);
+    if (!match || !TABLE_SYMBOLS.test(match[2])) {
+      continue;
+    }
+    const [, size, name] = match;
+    const label = name.startsWith('__compound_literal') ? 'key override literals' : name;
+    tables.set(label, (tables.get(label) || 0) + parseInt(size, 16));
+  }
+  return tables;
+}
+
+/**
+ * Check one build target against its keymap's budget
+ * Returns false if the budget is exceeded
+ */
+function checkTarget(rootDir, qmkHome, target) {
+  const name = `${target.keyboard}:${target.keymap} (${target.elfName})`;
+  const elfPath = path.join(qmkHome, '.build', `${target.elfName}.elf`);
+  if (!fs.existsSync(elfPath)) {
+    console.log(`  - ${name}: no build found at ${elfPath}`);
+    return true;
+  }
+
+  const budgetPath = path.join(rootDir, 'keyboards', target.keyboard, 'keymaps', target.keymap, BUDGET_FILE);
+  const budget = fs.existsSync(budgetPath) ? JSON.parse(fs.readFileSync(budgetPath, 'utf8')) : {};
+
+  const prefix = toolPrefix(elfPath);
+  const sections = readSections(elfPath, prefix);
+  const tables = readTables(elfPath, prefix);
+
+  console.log(`\n${name}`);
+  console.log('  Section                 Bytes  Flash  RAM');
+  for (const section of sections) {
+    console.log(`  ${section.name.padEnd(20)} ${String(section.size).padStart(8)}  ${section.flash ? '  x  ' : '     '}  ${section.ram ? ' x' : ''}`);
+  }
+  if (tables.size > 0) {
+    console.log('\n  Keymap table            Bytes');
+    for (const [table, size] of tables) {
+      console.log(`  ${table.padEnd(20)} ${String(size).padStart(8)}`);
+    }
+  }
+
+  let ok = true;
+  for (const region of ['flash', 'ram']) {
+    const used = sections.filter(section => section[region]).reduce((sum, section) => sum + section.size, 0);
+    const limit = budget[region];
+    if (limit === undefined) {
+      console.log(`\n  ${region.toUpperCase()}: ${used} bytes (no budget set)`);
+      continue;
+    }
+    const status = used > limit ? '✗ over budget' : '✓';
+    console.log(`\n  ${region.toUpperCase()}: ${used} / ${limit} bytes (${Math.round(used / limit * 100)}%) ${status}`);
+    ok = ok && used <= limit;
+  }
+  return ok;
+}
+
+/**
+ * Main function
+ */
+function main() {
+  const rootDir = path.join(__dirname, '..');
+  const args = process.argv.slice(2);
+  const qmkHomeIdx = args.indexOf('--qmk-home');
+  const qmkHome = qmkHomeIdx !== -1 ? args.splice(qmkHomeIdx, 2)[1] : findQmkHome();
+
+  if (!qmkHome) {
+    console.error('Cannot determine qmk_firmware location. Set QMK_HOME or pass --qmk-home');
+    process.exit(1);
+  }
+
+  const results = findTargets(rootDir, args).map(target => checkTarget(rootDir, qmkHome, target));
+  if (results.includes(false)) {
+    console.error(`\n✗ Firmware is over its size budget (see ${BUDGET_FILE})`);
+    process.exit(1);
+  }
+}
+
+// Run if executed directly
+if (require.main === module) {
+  main();
+}
+
+module.exports = { findTargets, readSections, readTables, checkTarget };
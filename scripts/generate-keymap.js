@@ -0,0 +1,517 @@
+#!/usr/bin/env node
+
+const fs = require('fs');
+const path = require('path');
+const { discoverKeymaps } = require('./discover-keymaps');
+const { OUTPUT_PROFILES, DEFAULT_PROFILE, HOLD_MODS, keycodeForLabel, profileAliases, composeSequences, shiftedLabel } = require('./keymap-labels');
+
+// Try to require js-yaml from website/node_modules when run from website/
+let yaml;
+try {
+  yaml = require('js-yaml');
+} catch (error) {
+  // If not found, try from website/node_modules (when run from root)
+  const yamlPath = path.join(__dirname, '..', 'website', 'node_modules', 'js-yaml');
+  yaml = require(yamlPath);
+}
+
+// One header per output profile, chosen by OUTPUT_PROFILE in rules.mk
+const outputFile = profile => `keymap_tables_${profile}.h`;
+
+// Slots of a symbol table row, in the order of enum symbol_class in keymap.c
+const SYMBOL_CLASSES = ['ALT', 'SHIFT_ALT', 'SHIFT'];
+
+// Modifiers that every override in a slot needs, one of which must be held for
+// a row to match: Alt for both Alt classes (Shift alone is common, for capitals)
+const CLASS_GATE_MODS = { ALT: 'MOD_MASK_ALT', SHIFT_ALT: 'MOD_MASK_ALT', SHIFT: 'MOD_MASK_SHIFT' };
+
+// Alt outputs that edit text, and so should still work with Ctrl or Command held
+const EDIT_KEYCODES = ['KC_ENTER', 'KC_BSPC', 'KC_DEL', 'KC_DELETE_WORD'];
+
+// Keycodes IS_BASIC_KEYCODE() accepts
+const BASIC_KEYCODE = /^KC_([A-Z0-9]|SCLN|COMM|DOT|SLSH|QUOT|GRV|MINS|EQL|LBRC|RBRC|BSLS|SPACE|SPC|ENTER|ENT|ESC|TAB|BSPC|DEL|LEFT|RIGHT|UP|DOWN|KP_\d|F\d+)$/;
+
+// Matrix position to layout.yaml position, per layout
+const MATRIX_LAYOUTS = {
+  // Left half is rows 0-3, right half rows 4-7 with columns mirrored.
+  // Thumbs are in columns 3 and 4 of rows 3 and 7.
+  LAYOUT_split_3x5_2: {
+    cols: 5,
+    position(row, col) {
+      if (row === 3) return col === 3 ? 30 : 31;
+      if (row === 7) return col === 4 ? 32 : 33;
+      return row < 4 ? row * 10 + col : (row - 4) * 10 + 9 - col;
+    }
+  }
+};
+
+/**
+ * Find out whether a layout.yaml layer is a real layer or a ghost layer
+ * Ghost layers are named after a real layer plus the modifiers held on it,
+ * e.g. BASE_SHIFT_ALT is BASE with Shift and Alt held, ALT_NAV is NAV with Alt
+ */
+function classifyLayer(name) {
+  const tokens = name.split('_');
+  const mods = tokens.filter(token => token === 'SHIFT' || token === 'ALT');
+
+  if (mods.length === 0) {
+    return { name, real: true };
+  }
+
+  return {
+    name,
+    real: false,
+    base: tokens.filter(token => !mods.includes(token)).join('_'),
+    symbolClass: SYMBOL_CLASSES.find(symbolClass => symbolClass.split('_').sort().join('_') === mods.sort().join('_'))
+  };
+}
+
+/**
+ * Which hand a position is on (split_3x5_2: 3 rows of 10, then 4 thumbs)
+ */
+function handForPosition(position) {
+  if (position >= 30) {
+    return position < 32 ? 'L' : 'R';
+  }
+  return position % 10 < 5 ? 'L' : 'R';
+}
+
+/**
+ * Get the keycode for the tap label of a key
+ */
+function keycodeForTap(label, where, profile) {
+  const toMatch = String(label).match(/^TO\((\w+)\)$/);
+  if (toMatch) {
+    return `TO(${toMatch[1]})`;
+  }
+
+  const osmMatch = String(label).match(/^OSM (\w+)$/);
+  if (osmMatch && HOLD_MODS[osmMatch[1]]) {
+    return `OSM(${HOLD_MODS[osmMatch[1]].L})`;
+  }
+
+  const keycode = keycodeForLabel(String(label), profile);
+  if (!keycode) {
+    throw new Error(`Unknown key label "${label}" (${where})`);
+  }
+  return keycode;
+}
+
+/**
+ * Parse a key definition from layout.yaml, as typed with an output profile
+ * Returns the tap label, the keycode for keymaps[], and the tap keycode that
+ * key overrides trigger on
+ */
+function parseKey(keyDef, position, where, profile = DEFAULT_PROFILE) {
+  if (keyDef === null || keyDef === undefined || keyDef === '') {
+    return { label: null, keycode: 'KC_NO', tap: 'KC_NO' };
+  }
+
+  if (typeof keyDef !== 'object') {
+    const keycode = keycodeForTap(keyDef, where, profile);
+    return { label: String(keyDef), keycode, tap: keycode };
+  }
+
+  if (keyDef.type === 'held') {
+    return { label: null, held: true, keycode: 'KC_TRNS', tap: 'KC_TRNS' };
+  }
+
+  const tap = keycodeForTap(keyDef.t, where, profile);
+  if (!keyDef.h) {
+    return { label: String(keyDef.t), keycode: tap, tap };
+  }
+
+  const holdMods = HOLD_MODS[keyDef.h];
+  if (!holdMods) {
+    throw new Error(`Unknown hold label "${keyDef.h}" (${where})`);
+  }
+  return { label: String(keyDef.t), keycode: `MT(${holdMods[handForPosition(position)]}, ${tap})`, tap };
+}
+
+/**
+ * Parse a ghost layer key
+ * Only its label is needed up front: it is turned into a keycode if the key
+ * turns out to need an override
+ */
+function parseGhostKey(keyDef) {
+  if (keyDef === null || keyDef === undefined || keyDef === '') {
+    return { label: null };
+  }
+  if (typeof keyDef !== 'object') {
+    return { label: String(keyDef) };
+  }
+  if (keyDef.type === 'held') {
+    return { label: null, held: true };
+  }
+  return { label: String(keyDef.t) };
+}
+
+/**
+ * Key overrides can trigger on basic keycodes and the repeat key. Shifted
+ * aliases such as KC_LPRN are modded keycodes: the engine never sees them as
+ * the keycode of a key press, and symbol_rows[] can't index them.
+ */
+function isTrigger(keycode) {
+  return keycode === 'QK_REPEAT_KEY' || BASIC_KEYCODE.test(keycode);
+}
+
+/**
+ * Work out the override a ghost layer key needs, if any
+ * A ghost key that shows what the modifier would type anyway needs none.
+ * An empty ghost key blocks the Alt or Shift+Alt combination.
+ */
+function overrideFor(realKey, ghostKey, symbolClass, where, profile) {
+  // Layer keys, modded keycodes (the SYMBOL layer) and the like only label their ghost keys
+  const keycode = realKey.tap === 'QK_REPEAT_KEY' || /^KC_\w+$/.test(realKey.tap);
+  if (!keycode || ghostKey.held || realKey.tap === 'KC_NO' || realKey.tap === 'KC_TRNS') {
+    return null;
+  }
+
+  let output;
+  if (ghostKey.label === null) {
+    if (symbolClass === 'SHIFT' || realKey.tap === 'QK_REPEAT_KEY') {
+      return null;
+    }
+    output = 'KC_NO';
+  } else if (ghostKey.label === realKey.label) {
+    return null;
+  } else if (symbolClass === 'SHIFT' && ghostKey.label === shiftedLabel(realKey.label)) {
+    return null;
+  } else {
+    output = keycodeForTap(ghostKey.label, where, profile);
+    // A label for what Alt types anyway, such as ˜ for Alt+N on macOS
+    if (symbolClass === 'ALT' && output === `LALT(${realKey.tap})`) {
+      return null;
+    }
+  }
+
+  if (!isTrigger(realKey.tap)) {
+    throw new Error(`${realKey.label} (${realKey.tap}) can't trigger a symbol, only basic keycodes and QK_REPEAT_KEY can (${where})`);
+  }
+  return { output };
+}
+
+/**
+ * Build the symbol table: one row per trigger keycode, one slot per class
+ * Rows are ordered by where their key first appears in the real layers
+ */
+function buildSymbolRows(layers, profile = DEFAULT_PROFILE) {
+  const rows = new Map();
+
+  for (const ghost of layers.filter(layer => !layer.real)) {
+    const real = layers.find(layer => layer.real && layer.name === ghost.base);
+    if (!real) {
+      throw new Error(`Ghost layer ${ghost.name} has no real layer ${ghost.base}`);
+    }
+
+    ghost.keys.forEach((ghostKey, position) => {
+      const realKey = real.keys[position];
+      const override = overrideFor(realKey, ghostKey, ghost.symbolClass, `${ghost.name}, position ${position}`, profile);
+      if (!override) {
+        return;
+      }
+
+      if (!rows.has(realKey.tap)) {
+        rows.set(realKey.tap, {});
+      }
+      const row = rows.get(realKey.tap);
+      const existing = row[ghost.symbolClass];
+      if (existing && existing.output !== override.output) {
+        throw new Error(`${ghost.name} gives ${realKey.label} ${override.output}, but another layer gives it ${existing.output}`);
+      }
+      row[ghost.symbolClass] = override;
+    });
+  }
+
+  const order = layers.filter(layer => layer.real).flatMap(layer => layer.keys.map(key => key.tap));
+  return Array.from(rows.entries())
+    .sort(([a], [b]) => order.indexOf(a) - order.indexOf(b))
+    .map(([trigger, slots]) => ({
+      trigger,
+      name: `${trigger.replace(/^(KC|QK)_/, '').replace(/_KEY$/, '')}_SYMBOLS`,
+      slots
+    }));
+}
+
+/**
+ * Name and C expression of the override in one slot of a symbol table row
+ * The macros are defined in keymap.c. Blocked slots of the same kind share
+ * one override with a KC_NO trigger, which load_symbol_row() disables in the
+ * engine's copy.
+ */
+function slotOverride(row, symbolClass) {
+  const slot = row.slots[symbolClass];
+  if (!slot) {
+    return null;
+  }
+
+  const alt = row.slots.ALT;
+  const editRow = alt !== undefined && EDIT_KEYCODES.includes(alt.output);
+
+  let macro;
+  if (symbolClass === 'SHIFT') {
+    macro = 'SHIFTED';
+  } else if (symbolClass === 'ALT') {
+    macro = /^KC_F\d+$/.test(slot.output) ? 'ALT_FN' : editRow ? 'ALT_EDIT' : 'ALT_SYMBOL';
+  } else {
+    macro = editRow ? 'SHIFT_ALT_EDIT' : 'SHIFT_ALT_SYMBOL';
+  }
+
+  if (slot.output === 'KC_NO') {
+    return { name: `${macro.replace(/_SYMBOL$/, '')}_BLOCKED_OVERRIDE`, expression: `${macro}(KC_NO, KC_NO)` };
+  }
+  return {
+    name: `${row.name.replace(/_SYMBOLS$/, '')}_${symbolClass}_OVERRIDE`,
+    expression: `${macro}(${row.trigger}, ${slot.output})`
+  };
+}
+
+/**
+ * Render keymaps[] in LAYOUT_split_3x5_2 order
+ */
+function renderKeymaps(realLayers) {
+  const lines = ['const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {'];
+
+  realLayers.forEach((layer, index) => {
+    const keys = layer.keys.map(key => key.keycode);
+    const halves = [];
+    for (let i = 0; i < 30; i += 5) {
+      halves.push(keys.slice(i, i + 5));
+    }
+    halves.push(keys.slice(30, 32), keys.slice(32, 34));
+
+    lines.push(`    [${layer.name}] = LAYOUT_split_3x5_2(`);
+    halves.forEach((half, i) => {
+      const last = i === halves.length - 1;
+      lines.push(`        ${half.join(', ')}${last ? '' : ','}`);
+      if (i % 2 === 1 && !last) {
+        lines.push('');
+      }
+    });
+    lines.push(`    )${index === realLayers.length - 1 ? '' : ','}`);
+  });
+
+  lines.push('};');
+  return lines;
+}
+
+/**
+ * Every distinct override, in enum symbol_override order (after NO_OVERRIDE),
+ * and the override in each slot of each row
+ */
+function collectOverrides(rows) {
+  const overrides = new Map();
+  const cells = rows.map(row => [
+    `[${row.name}]`,
+    ...SYMBOL_CLASSES.map(symbolClass => {
+      const override = slotOverride(row, symbolClass);
+      if (!override) {
+        return 'NO_OVERRIDE';
+      }
+      overrides.set(override.name, override.expression);
+      return override.name;
+    })
+  ]);
+  return { overrides, cells };
+}
+
+/**
+ * Render the symbol table, its row enum and the keycode -> row lookups
+ */
+function renderSymbols(rows) {
+  const lines = ['enum symbol_row {', '    NO_SYMBOLS,'];
+  rows.forEach(row => lines.push(`    ${row.name},`));
+  lines.push('    SYMBOL_ROW_COUNT', '};', '');
+
+  // Every distinct override, stored once in flash
+  const { overrides, cells } = collectOverrides(rows);
+
+  lines.push('enum symbol_override {', '    NO_OVERRIDE,');
+  overrides.forEach((expression, name) => lines.push(`    ${name},`));
+  lines.push('    SYMBOL_OVERRIDE_COUNT', '};', '');
+  lines.push('_Static_assert(SYMBOL_OVERRIDE_COUNT <= 256, "symbol_table[] indexes overrides with a uint8_t");', '');
+
+  const nameWidth = Math.max(...Array.from(overrides.keys()).map(name => name.length + 2));
+  lines.push('static const key_override_t PROGMEM symbol_overrides[SYMBOL_OVERRIDE_COUNT] = {');
+  Array.from(overrides.entries()).forEach(([name, expression], index) => {
+    lines.push(`    ${`[${name}]`.padEnd(nameWidth)} = ${expression}${index === overrides.size - 1 ? '' : ','}`);
+  });
+  lines.push('};', '');
+
+  const widths = [0, 1, 2].map(column => Math.max(...cells.map(cell => cell[column].length + (column === 0 ? 0 : 1))));
+  lines.push('// Override in each slot of each row, as an index into symbol_overrides[]');
+  lines.push('static const uint8_t PROGMEM symbol_table[SYMBOL_ROW_COUNT][SYMBOL_CLASS_COUNT] = {');
+  lines.push(`    //${''.padEnd(widths[0] + 2)}${'Alt'.padEnd(widths[1] + 1)}${'Shift+Alt'.padEnd(widths[2] + 1)}Shift`);
+  cells.forEach((cell, index) => {
+    const last = index === cells.length - 1;
+    lines.push(`    ${cell[0].padEnd(widths[0])} = {${`${cell[1]},`.padEnd(widths[1] + 1)}${`${cell[2]},`.padEnd(widths[2] + 1)}${cell[3]}}${last ? '' : ','}`);
+  });
+  lines.push('};', '');
+
+  // Gate for each row: the mods held must include one of these for any of
+  // its slots to match
+  const gates = rows.map(row => {
+    const mods = new Set(SYMBOL_CLASSES.filter(symbolClass => row.slots[symbolClass]).map(symbolClass => CLASS_GATE_MODS[symbolClass]));
+    return mods.size > 1 ? 'MOD_MASK_SA' : Array.from(mods)[0];
+  });
+  const gateWidth = Math.max(...rows.map(row => row.name.length + 2));
+  lines.push('// Modifiers one of which must be held for any slot of each row to match');
+  lines.push('static const uint8_t PROGMEM symbol_row_mods[SYMBOL_ROW_COUNT] = {');
+  rows.forEach((row, index) => {
+    lines.push(`    ${`[${row.name}]`.padEnd(gateWidth)} = ${gates[index]}${index === rows.length - 1 ? '' : ','}`);
+  });
+  lines.push('};', '');
+
+  const basic = rows.filter(row => row.trigger.startsWith('KC_'));
+  const extended = rows.filter(row => !row.trigger.startsWith('KC_'));
+
+  lines.push('// Trigger keycode -> symbol row, for basic keycodes');
+  lines.push('static const uint8_t PROGMEM symbol_rows[] = {');
+  basic.forEach((row, index) => {
+    lines.push(`    [${row.trigger}] = ${row.name}${index === basic.length - 1 ? '' : ','}`);
+  });
+  lines.push('};', '');
+
+  lines.push('// Symbol rows of triggers outside the basic keycode range');
+  lines.push('static uint8_t extended_symbol_row(uint16_t keycode) {');
+  lines.push('    switch (keycode) {');
+  extended.forEach(row => {
+    lines.push(`        case ${row.trigger}:`, `            return ${row.name};`);
+  });
+  lines.push('        default:', '            return NO_SYMBOLS;', '    }', '}');
+  return lines;
+}
+
+/**
+ * Parse every layer of a layout.yaml, real and ghost, in file order
+ */
+function parseLayers(layoutData, profile = DEFAULT_PROFILE) {
+  return Object.entries(layoutData.layers).map(([name, rows]) => {
+    const layer = classifyLayer(name);
+    const keys = rows.flat().map((keyDef, position) =>
+      layer.real ? parseKey(keyDef, position, `${name}, position ${position}`, profile) : parseGhostKey(keyDef));
+    return { ...layer, keys };
+  });
+}
+
+/**
+ * Render an output profile's keycode aliases and Compose sequences, and list
+ * the labels it can't type
+ */
+function renderProfile(profile, layers) {
+  const lines = [`// Keycodes for the ${profile} output profile (${OUTPUT_PROFILES[profile].description})`];
+  Object.entries(profileAliases(profile)).forEach(([alias, keycode]) => lines.push(`#define ${alias} ${keycode}`));
+
+  const labels = new Set(layers.flatMap(layer => layer.keys.map(key => key.label)).filter(label => label !== null));
+  const missing = Array.from(labels).filter(label => keycodeForLabel(label, profile) === 'KC_NO');
+  if (missing.length > 0) {
+    lines.push('', `// Not available with this profile, so typed as KC_NO: ${missing.join(' ')}`);
+  }
+
+  const sequences = composeSequences(profile);
+  lines.push('', `#define COMPOSE_SEQUENCE_COUNT ${sequences.length}`);
+  if (sequences.length === 0) {
+    return lines;
+  }
+
+  const length = Math.max(...sequences.map(sequence => sequence.keys.length));
+  lines.push(`#define COMPOSE_SEQUENCE_LENGTH ${length}`, '');
+  lines.push('// Keys typed after COMPOSE_KEY for each COMPOSED() keycode', 'enum compose_sequence {');
+  sequences.forEach(sequence => lines.push(`    COMPOSE_${sequence.compose},`));
+  lines.push('};', '');
+
+  const nameWidth = Math.max(...sequences.map(sequence => sequence.compose.length + 10));
+  lines.push('static const uint16_t PROGMEM compose_sequences[COMPOSE_SEQUENCE_COUNT][COMPOSE_SEQUENCE_LENGTH] = {');
+  sequences.forEach((sequence, index) => {
+    const keys = [...sequence.keys, ...new Array(length - sequence.keys.length).fill('KC_NO')];
+    lines.push(`    ${`[COMPOSE_${sequence.compose}]`.padEnd(nameWidth)} = {${keys.join(', ')}}${index === sequences.length - 1 ? '' : ','}`);
+  });
+  lines.push('};');
+  return lines;
+}
+
+/**
+ * Generate keymap_tables_<profile>.h for a layout.yaml
+ */
+function generateTables(layoutPath, profile = DEFAULT_PROFILE) {
+  const layoutData = yaml.load(fs.readFileSync(layoutPath, 'utf8'));
+
+  const layers = parseLayers(layoutData, profile);
+  const realLayers = layers.filter(layer => layer.real);
+  const rows = buildSymbolRows(layers, profile);
+
+  const lines = [
+    `// Generated by scripts/generate-keymap.js from ${path.basename(layoutPath)}. Do not edit:`,
+    `// change ${path.basename(layoutPath)} and run \`node scripts/generate-keymap.js\` instead.`,
+    '#pragma once',
+    '',
+    ...renderProfile(profile, layers),
+    '',
+    'enum layer_names {',
+    ...realLayers.map(layer => `    ${layer.name},`),
+    '    LAYER_COUNT',
+    '};',
+    '',
+    ...renderKeymaps(realLayers),
+    '',
+    ...renderSymbols(rows)
+  ];
+
+  return `${lines.join('\n')}\n`;
+}
+
+/**
+ * Main function
+ * With --check, fails if any generated file is out of date instead of writing it.
+ * --out-dir <dir> writes the tables to <dir>/<keymap id>/ instead of next to
+ * layout.yaml.
+ */
+function main() {
+  const args = process.argv.slice(2);
+  const check = args.includes('--check');
+  const outDirIndex = args.indexOf('--out-dir');
+  const outDir = outDirIndex === -1 ? null : path.resolve(args[outDirIndex + 1]);
+  const rootDir = path.join(__dirname, '..');
+  const keymaps = discoverKeymaps(path.join(rootDir, 'keyboards'));
+
+  let stale = 0;
+  for (const keymap of keymaps) {
+    const keymapDir = outDir ? path.join(outDir, keymap.id) : path.dirname(keymap.path);
+    fs.mkdirSync(keymapDir, { recursive: true });
+    for (const profile of Object.keys(OUTPUT_PROFILES)) {
+      const outputPath = path.join(keymapDir, outputFile(profile));
+      const relativePath = path.relative(rootDir, outputPath);
+
+      let tables;
+      try {
+        tables = generateTables(keymap.path, profile);
+      } catch (error) {
+        console.error(`✗ ${keymap.id} (${profile}): ${error.message}`);
+        process.exit(1);
+      }
+
+      const current = fs.existsSync(outputPath) ? fs.readFileSync(outputPath, 'utf8') : null;
+      if (current === tables) {
+        console.log(`  ✓ ${relativePath} is up to date`);
+      } else if (check) {
+        console.error(`  ✗ ${relativePath} is out of date`);
+        stale++;
+      } else {
+        fs.writeFileSync(outputPath, tables);
+        console.log(`  ✓ Wrote ${relativePath}`);
+      }
+    }
+  }
+
+  if (stale > 0) {
+    console.error('\nRun `node scripts/generate-keymap.js` and commit the result.');
+    process.exit(1);
+  }
+}
+
+// Run if executed directly
+if (require.main === module) {
+  main();
+}
+
+module.exports = { MATRIX_LAYOUTS, classifyLayer, parseKey, parseLayers, buildSymbolRows, collectOverrides, generateTables };
@@ -1,8 +1,20 @@
 #!/usr/bin/env node
 
 const fs = require('fs');
+const os = require('os');
 const path = require('path');
-const { execSync } = require('child_process');
+const crypto = require('crypto');
+const { execSync, execFile } = require('child_process');
+const { promisify } = require('util');
+
+const execFileAsync = promisify(execFile);
+
+// Hashes of the inputs each SVG was last drawn from, and the SVGs themselves,
+// are kept in website/.cache (restored by the website workflow) and copied to
+// the output directory, which is cleaned by the build
+const CACHE_FILE = '.svg-cache.json';
+const CACHE_SVG_DIR = 'svgs';
+const DEFAULT_CACHE_DIR = path.join(__dirname, '..', 'website', '.cache');
 
 // Try to require js-yaml from website/node_modules when run from website/
 let yaml;
@@ -64,73 +76,144 @@ function extractKeymapId(layoutPath) {
 }
 
 /**
- * Extract layer names from layout.yaml
+ * Load a layout.yaml, or null if it can't be parsed
  */
-function getLayerNames(layoutPath) {
+function loadLayout(layoutPath) {
   try {
-    const fileContents = fs.readFileSync(layoutPath, 'utf8');
-    const data = yaml.load(fileContents);
-
-    if (!data.layers) {
-      return [];
-    }
-
-    return Object.keys(data.layers);
+    return yaml.load(fs.readFileSync(layoutPath, 'utf8'));
   } catch (error) {
     console.error(`Error parsing ${layoutPath}: ${error.message}`);
-    return [];
+    return null;
   }
 }
 
 /**
- * Generate SVGs for a layout.yaml file using keymap-drawer
+ * Load the hashes of the SVGs drawn by earlier runs
  */
-function generateSvgs(layoutPath, outputDir) {
-  const keymapId = extractKeymapId(layoutPath);
-  const svgOutputDir = path.join(outputDir, keymapId);
-
-  // Create output directory
-  if (!fs.existsSync(svgOutputDir)) {
-    fs.mkdirSync(svgOutputDir, { recursive: true });
+function loadCache(cacheDir) {
+  try {
+    return JSON.parse(fs.readFileSync(path.join(cacheDir, CACHE_FILE), 'utf8'));
+  } catch (error) {
+    return { svgs: {} };
   }
+}
 
-  console.log(`Generating SVGs for: ${keymapId}`);
-  console.log(`  Input:  ${layoutPath}`);
-  console.log(`  Output: ${svgOutputDir}`);
+function saveCache(cacheDir, cache) {
+  fs.mkdirSync(cacheDir, { recursive: true });
+  fs.writeFileSync(path.join(cacheDir, CACHE_FILE), `${JSON.stringify(cache, null, 2)}\n`);
+}
 
-  // Get layer names from layout.yaml
-  const layerNames = getLayerNames(layoutPath);
+/**
+ * Content hash of everything keymap draw reads to draw one layer
+ * That is the whole file apart from the other layers (the physical layout,
+ * draw config and combos can all change the drawing), plus the keymap-drawer
+ * version.
+ */
+function layerHash(data, layerName, drawerVersion) {
+  const inputs = { ...data, layers: { [layerName]: data.layers[layerName] }, drawerVersion };
+  return crypto.createHash('sha256').update(JSON.stringify(inputs)).digest('hex');
+}
 
+/**
+ * Work out which layers of a layout.yaml need drawing
+ * Returns one task per layer, marked cached if its SVG in the cache directory
+ * is up to date
+ */
+function planSvgs(layoutPath, cacheDir, cache, drawerVersion, force) {
+  const keymapId = extractKeymapId(layoutPath);
+  fs.mkdirSync(path.join(cacheDir, CACHE_SVG_DIR, keymapId), { recursive: true });
+
+  const data = loadLayout(layoutPath);
+  const layerNames = data && data.layers ? Object.keys(data.layers) : [];
   if (layerNames.length === 0) {
-    console.error(`  ✗ No layers found in ${layoutPath}\n`);
-    throw new Error('No layers found');
+    throw new Error(`No layers found in ${layoutPath}`);
   }
 
-  console.log(`  Layers: ${layerNames.join(', ')}`);
+  return layerNames.map(layerName => {
+    const file = `${keymapId}/${layerName.toLowerCase()}.svg`;
+    const outputFile = path.join(cacheDir, CACHE_SVG_DIR, file);
+    const hash = layerHash(data, layerName, drawerVersion);
+    const cached = !force && cache.svgs[file] === hash && fs.existsSync(outputFile);
+    return { keymapId, layoutPath, layerName, file, outputFile, hash, cached };
+  });
+}
 
-  // Generate SVG for each layer
-  let generatedCount = 0;
-  for (const layerName of layerNames) {
-    const outputFile = path.join(svgOutputDir, `${layerName.toLowerCase()}.svg`);
+/**
+ * Run keymap draw for each task, up to `jobs` processes at a time
+ * Python startup dominates each run, so they are spawned side by side
+ * instead of one after another.
+ */
+async function drawSvgs(tasks, jobs) {
+  let next = 0;
+  const worker = async () => {
+    while (next < tasks.length) {
+      const task = tasks[next++];
+      const started = process.hrtime.bigint();
+      try {
+        await execFileAsync('keymap', ['draw', task.layoutPath, '-s', task.layerName, '-o', task.outputFile]);
+      } catch (error) {
+        task.error = error;
+      }
+      task.seconds = Number(process.hrtime.bigint() - started) / 1e9;
+    }
+  };
+  await Promise.all(Array.from({ length: Math.min(jobs, tasks.length) }, worker));
+}
 
+/**
+ * Generate SVGs for layout.yaml files using keymap-drawer
+ * Draws the layers whose inputs changed since the last run into the cache
+ * directory, then copies every layer's SVG to outputDir. Returns the tasks,
+ * with `error` set on those that failed, and the layouts that couldn't be
+ * planned at all.
+ */
+async function generateSvgs(layoutPaths, outputDir, options = {}) {
+  const drawerVersion = options.drawerVersion || execSync('keymap --version', { encoding: 'utf8' }).trim();
+  const cacheDir = options.cacheDir || DEFAULT_CACHE_DIR;
+  const jobs = options.jobs || os.cpus().length;
+  const started = process.hrtime.bigint();
+  const cache = loadCache(cacheDir);
+
+  const tasks = [];
+  const failures = [];
+  for (const layoutPath of [].concat(layoutPaths)) {
     try {
-      // Run keymap draw command for this layer
-      const cmd = `keymap draw "${layoutPath}" -s ${layerName} -o "${outputFile}"`;
-      execSync(cmd, { stdio: 'pipe' });
-      generatedCount++;
+      tasks.push(...planSvgs(layoutPath, cacheDir, cache, drawerVersion, options.force));
     } catch (error) {
-      console.error(`  ✗ Error generating ${layerName}: ${error.message}`);
-      throw error;
+      failures.push({ layoutPath, error });
     }
   }
 
-  console.log(`  ✓ Generated ${generatedCount} SVG(s) successfully\n`);
+  const stale = tasks.filter(task => !task.cached);
+  await drawSvgs(stale, jobs);
+  stale.filter(task => !task.error).forEach(task => { cache.svgs[task.file] = task.hash; });
+
+  for (const task of tasks.filter(task => !task.error)) {
+    const target = path.join(outputDir, task.file);
+    fs.mkdirSync(path.dirname(target), { recursive: true });
+    fs.copyFileSync(task.outputFile, target);
+  }
+
+  const seconds = Number(process.hrtime.bigint() - started) / 1e9;
+  if (stale.length === tasks.length && tasks.length > 0 && !tasks.some(task => task.error) && failures.length === 0) {
+    cache.coldRun = { svgs: tasks.length, seconds: Number(seconds.toFixed(2)) };
+  }
+  saveCache(cacheDir, cache);
+
+  return { tasks, failures, seconds, coldRun: cache.coldRun };
 }
 
 /**
  * Main function
+ * --force redraws every SVG, and --jobs N limits how many keymap draw
+ * processes run at once (one per CPU by default)
  */
-function main() {
+async function main() {
+  const args = process.argv.slice(2);
+  const force = args.includes('--force');
+  const jobsIdx = args.indexOf('--jobs');
+  const jobs = jobsIdx === -1 ? os.cpus().length : Math.max(1, parseInt(args[jobsIdx + 1], 10) || 1);
+
   const rootDir = path.join(__dirname, '..');
   const keyboardsDir = path.join(rootDir, 'keyboards');
   const outputDir = path.join(rootDir, 'website', 'public', 'generated');
@@ -138,8 +221,9 @@ function main() {
   console.log('=== Keymap SVG Generator ===\n');
 
   // Check if keymap is installed (from keymap-drawer package)
+  let drawerVersion;
   try {
-    execSync('keymap --version', { stdio: 'pipe' });
+    drawerVersion = execSync('keymap --version', { encoding: 'utf8', stdio: 'pipe' }).trim();
   } catch (error) {
     console.error('ERROR: keymap (from keymap-drawer) is not installed!');
     console.error('Install it with: pip install keymap-drawer');
@@ -158,31 +242,48 @@ function main() {
 
   console.log(`Found ${layoutFiles.length} layout file(s):\n`);
 
-  // Generate SVGs for each layout
-  let successCount = 0;
-  let errorCount = 0;
+  const { tasks, failures, seconds, coldRun } = await generateSvgs(layoutFiles, outputDir, { drawerVersion, force, jobs });
 
   for (const layoutPath of layoutFiles) {
-    try {
-      generateSvgs(layoutPath, outputDir);
-      successCount++;
-    } catch (error) {
-      errorCount++;
+    const planned = tasks.filter(task => task.layoutPath === layoutPath);
+    const failure = failures.find(entry => entry.layoutPath === layoutPath);
+    if (failure) {
+      console.error(`  ✗ ${failure.error.message}\n`);
+      continue;
     }
+    console.log(`${planned[0].keymapId}: ${planned.length} layer(s), ${planned.filter(task => !task.cached).length} drawn`);
+    console.log(`  Input:  ${layoutPath}`);
+    console.log(`  Output: ${path.join(outputDir, planned[0].keymapId)}\n`);
   }
 
+  const stale = tasks.filter(task => !task.cached);
+  const failed = stale.filter(task => task.error);
+  failed.forEach(task => console.error(`  ✗ Error generating ${task.keymapId} ${task.layerName}: ${task.error.message}`));
+  const drawSeconds = stale.reduce((sum, task) => sum + task.seconds, 0);
+
+  const keymapErrors = new Set(failed.map(task => task.keymapId)).size + failures.length;
   console.log('=== Summary ===');
-  console.log(`✓ Success: ${successCount}`);
-  console.log(`✗ Errors:  ${errorCount}`);
+  console.log(`✓ Success: ${layoutFiles.length - keymapErrors}`);
+  console.log(`✗ Errors:  ${keymapErrors}`);
+  console.log(`\nDrew ${stale.length - failed.length} of ${tasks.length} SVG(s), ${tasks.length - stale.length} unchanged, in ${seconds.toFixed(2)}s`);
+  if (stale.length > 0) {
+    console.log(`  ${jobs} job(s), ${drawSeconds.toFixed(2)}s of keymap draw time`);
+  }
+  if (coldRun) {
+    console.log(`  Last cold run: ${coldRun.svgs} SVG(s) in ${coldRun.seconds.toFixed(2)}s`);
+  }
 
-  if (errorCount > 0) {
+  if (keymapErrors > 0) {
     process.exit(1);
   }
 }
 
 // Run if executed directly
 if (require.main === module) {
-  main();
+  main().catch(err => {
+    console.error(err);
+    process.exit(1);
+  });
 }
 
-module.exports = { findLayoutYamls, extractKeymapId, generateSvgs };
+module.exports = { findLayoutYamls, extractKeymapId, layerHash, planSvgs, drawSvgs, generateSvgs };
@@ -0,0 +1,292 @@
+/**
+ * Key labels used in layout.yaml, and the QMK keycodes they stand for.
+ *
+ * layout.yaml is written for people (and keymap-drawer), so its labels are the
+ * characters a key types rather than QMK keycodes. generate-keymap.js uses
+ * these tables to turn them back into keycodes. Labels whose keycodes depend
+ * on the host OS and its keyboard layout are in OUTPUT_PROFILES.
+ */
+
+const LABEL_KEYCODES = {
+  // Editing and navigation
+  'Esc': 'KC_ESC',
+  'Tab': 'KC_TAB',
+  'Enter': 'KC_ENTER',
+  'BSpace': 'KC_BSPC',
+  'Del': 'KC_DEL',
+  'Space': 'KC_SPACE',
+  'Left': 'KC_LEFT',
+  'Down': 'KC_DOWN',
+  'Up': 'KC_UP',
+  'Right': 'KC_RIGHT',
+  'Shift+Tab': 'LSFT(KC_TAB)',
+  'Shift+Enter': 'LSFT(KC_ENTER)',
+  'Ctrl+Shift+Tab': 'KC_NAV_PREV_TAB',
+  'Ctrl+Tab': 'KC_NAV_NEXT_TAB',
+  'Repeat': 'QK_REPEAT_KEY',
+  'Alt Repeat': 'QK_ALT_REPEAT_KEY',
+  'Trans': 'KC_TRNS',
+
+  // Mouse keys
+  'Mouse Left': 'MS_LEFT',
+  'Mouse Down': 'MS_DOWN',
+  'Mouse Up': 'MS_UP',
+  'Mouse Right': 'MS_RGHT',
+  'Left Click': 'MS_BTN1',
+  'Right Click': 'MS_BTN2',
+  'Middle Click': 'MS_BTN3',
+  'Wheel Left': 'MS_WHLL',
+  'Wheel Down': 'MS_WHLD',
+  'Wheel Up': 'MS_WHLU',
+  'Wheel Right': 'MS_WHLR',
+
+  // Punctuation
+  '.': 'KC_DOT',
+  ',': 'KC_COMM',
+  ';': 'KC_SCLN',
+  '/': 'KC_SLSH',
+  '-': 'KC_MINUS',
+  '=': 'KC_EQUAL',
+  '[': 'KC_LBRC',
+  ']': 'KC_RBRC',
+  '\\': 'KC_BACKSLASH',
+  "'": 'KC_QUOTE',
+  '`': 'KC_GRAVE',
+
+  // Shifted punctuation
+  ':': 'KC_COLN',
+  '?': 'KC_QUES',
+  '<': 'KC_LABK',
+  '>': 'KC_RABK',
+  '"': 'KC_DQUO',
+  '~': 'KC_TILDE',
+  '_': 'KC_UNDERSCORE',
+  '+': 'KC_PLUS',
+  '{': 'KC_LCBR',
+  '}': 'KC_RCBR',
+  '|': 'KC_PIPE',
+  '!': 'KC_EXCLAIM',
+  '@': 'KC_AT',
+  '$': 'KC_DOLLAR',
+  '%': 'KC_PERCENT',
+  '^': 'KC_CIRCUMFLEX',
+  '&': 'KC_AMPERSAND',
+  '*': 'KC_ASTERISK',
+  '(': 'KC_LPRN',
+  ')': 'KC_RPRN'
+};
+
+/**
+ * A Compose key sequence, typed after COMPOSE_KEY (see keymap.c)
+ */
+function compose(name, ...keys) {
+  return { compose: name, keys };
+}
+
+// Keys that are the same on every host
+const COMMON_ALIASES = {
+  KC_NAV_PREV_TAB: 'LCTL(LSFT(KC_TAB))',
+  KC_NAV_NEXT_TAB: 'RCTL(KC_TAB)'
+};
+
+// Linux with the US layout
+const LINUX_US = {
+  description: 'Linux, US layout',
+  aliases: {
+    KC_NAV_HISTORY_BACK: 'LALT(KC_LEFT)',
+    KC_NAV_HISTORY_FORWARD: 'LALT(KC_RIGHT)',
+    KC_DELETE_WORD: 'LCTL(KC_BSPC)'
+  },
+  labels: {
+    'Del Word': 'KC_DELETE_WORD',
+    'Cmd+[': 'KC_NAV_HISTORY_BACK',
+    'Cmd+]': 'KC_NAV_HISTORY_FORWARD',
+    '#': 'KC_HASH'
+  }
+};
+
+// Labels whose keycodes depend on the host OS and its keyboard layout, one set
+// per output profile. Each profile has its own keymap_tables_<profile>.h, and
+// OUTPUT_PROFILE in rules.mk picks one at compile time. A label that another
+// profile knows but this one can't type becomes KC_NO.
+const OUTPUT_PROFILES = {
+  // macOS with the British layout: # and € are Alt+3 and Alt+2, and Alt+key
+  // types the symbols on the SYMBOL layer
+  macos_uk: {
+    description: 'macOS, British layout',
+    aliases: {
+      KC_DOUBLE_QUOTE_OPEN: 'LALT(KC_LEFT_BRACKET)',
+      KC_DOUBLE_QUOTE_CLOSE: 'LALT(LSFT(KC_LEFT_BRACKET))',
+      KC_SINGLE_QUOTE_OPEN: 'LALT(KC_RIGHT_BRACKET)',
+      KC_SINGLE_QUOTE_CLOSE: 'LALT(LSFT(KC_RIGHT_BRACKET))',
+      KC_UK_HASH: 'LALT(KC_3)',
+      KC_UK_POUND: 'LSFT(KC_3)',
+      KC_EURO: 'LALT(KC_2)',
+      KC_NAV_HISTORY_BACK: 'LGUI(KC_LEFT_BRACKET)',
+      KC_NAV_HISTORY_FORWARD: 'LGUI(KC_RIGHT_BRACKET)',
+      KC_DELETE_WORD: 'LALT(KC_BSPC)'
+    },
+    labels: {
+      'Del Word': 'KC_DELETE_WORD',
+      'Cmd+[': 'KC_NAV_HISTORY_BACK',
+      'Cmd+]': 'KC_NAV_HISTORY_FORWARD',
+      '#': 'KC_UK_HASH',
+      '£': 'KC_UK_POUND',
+      '€': 'KC_EURO',
+      '“': 'KC_DOUBLE_QUOTE_OPEN',
+      '”': 'KC_DOUBLE_QUOTE_CLOSE',
+      '‘': 'KC_SINGLE_QUOTE_OPEN',
+      '’': 'KC_SINGLE_QUOTE_CLOSE',
+
+      // Alt+key symbols (SYMBOL layer)
+      'œ': 'LALT(KC_Q)',
+      '∑': 'LALT(KC_W)',
+      '´': 'LALT(KC_E)',
+      '®': 'LALT(KC_R)',
+      '†': 'LALT(KC_T)',
+      '¥': 'LALT(KC_Y)',
+      '¨': 'LALT(KC_U)',
+      'ˆ': 'LALT(KC_I)',
+      'ø': 'LALT(KC_O)',
+      'π': 'LALT(KC_P)',
+      'å': 'LALT(KC_A)',
+      'ß': 'LALT(KC_S)',
+      '∂': 'LALT(KC_D)',
+      'ƒ': 'LALT(KC_F)',
+      '©': 'LALT(KC_G)',
+      '˙': 'LALT(KC_H)',
+      '∆': 'LALT(KC_J)',
+      '˚': 'LALT(KC_K)',
+      '¬': 'LALT(KC_L)',
+      '…': 'LALT(KC_SCLN)',
+      'Ω': 'LALT(KC_Z)',
+      '≈': 'LALT(KC_X)',
+      'ç': 'LALT(KC_C)',
+      '√': 'LALT(KC_V)',
+      '∫': 'LALT(KC_B)',
+      '˜': 'LALT(KC_N)',
+      'µ': 'LALT(KC_M)',
+      '≤': 'LALT(KC_COMM)',
+      '≥': 'LALT(KC_DOT)',
+      '÷': 'LALT(KC_SLSH)'
+    }
+  },
+
+  // Linux with the US layout. Characters outside US ASCII can't be typed.
+  linux_us: LINUX_US,
+
+  // Linux with the US layout and a Compose key on Right Alt
+  // (setxkbmap -option compose:ralt). Characters the default Compose table
+  // has no sequence for (π, ∑, ∂ and the like) can't be typed.
+  linux_compose: {
+    description: 'Linux, US layout with Compose on Right Alt',
+    aliases: LINUX_US.aliases,
+    labels: {
+      ...LINUX_US.labels,
+      '£': compose('POUND', 'LSFT(KC_L)', 'KC_MINUS'),
+      '€': compose('EURO', 'KC_EQUAL', 'LSFT(KC_E)'),
+      '“': compose('DOUBLE_QUOTE_OPEN', 'KC_LABK', 'KC_DQUO'),
+      '”': compose('DOUBLE_QUOTE_CLOSE', 'KC_RABK', 'KC_DQUO'),
+      '‘': compose('SINGLE_QUOTE_OPEN', 'KC_LABK', 'KC_QUOTE'),
+      '’': compose('SINGLE_QUOTE_CLOSE', 'KC_RABK', 'KC_QUOTE'),
+      'œ': compose('OE', 'KC_O', 'KC_E'),
+      '´': compose('ACUTE', 'KC_QUOTE', 'KC_QUOTE'),
+      '®': compose('REGISTERED', 'KC_O', 'KC_R'),
+      '¥': compose('YEN', 'LSFT(KC_Y)', 'KC_EQUAL'),
+      '¨': compose('DIAERESIS', 'KC_DQUO', 'KC_DQUO'),
+      'ø': compose('O_SLASH', 'KC_SLSH', 'KC_O'),
+      'å': compose('A_RING', 'KC_O', 'KC_A'),
+      'ß': compose('SHARP_S', 'KC_S', 'KC_S'),
+      '©': compose('COPYRIGHT', 'KC_O', 'KC_C'),
+      '¬': compose('NOT', 'KC_MINUS', 'KC_COMM'),
+      '…': compose('ELLIPSIS', 'KC_DOT', 'KC_DOT'),
+      'ç': compose('C_CEDILLA', 'KC_COMM', 'KC_C'),
+      'µ': compose('MICRO', 'KC_M', 'KC_U'),
+      '≤': compose('LESS_EQUAL', 'KC_LABK', 'KC_UNDERSCORE'),
+      '≥': compose('GREATER_EQUAL', 'KC_RABK', 'KC_UNDERSCORE'),
+      '÷': compose('DIVIDE', 'KC_COLN', 'KC_MINUS')
+    }
+  }
+};
+
+// Profile of keymap_tables.h builds that don't set OUTPUT_PROFILE
+const DEFAULT_PROFILE = 'macos_uk';
+
+// Shifted label of each unshifted character, for spotting Shift overrides
+const SHIFTED_LABELS = {
+  ';': ':',
+  '/': '?',
+  ',': '<',
+  '.': '>',
+  "'": '"',
+  '`': '~',
+  '-': '_',
+  '=': '+',
+  '[': '{',
+  ']': '}',
+  '\\': '|'
+};
+
+// Hold labels of mod-taps, and the QMK mod for each hand
+const HOLD_MODS = {
+  'Gui': { L: 'MOD_LGUI', R: 'MOD_RGUI' },
+  'Ctrl': { L: 'MOD_LCTL', R: 'MOD_RCTL' },
+  'Alt': { L: 'MOD_LALT', R: 'MOD_RALT' },
+  'Shift': { L: 'MOD_LSFT', R: 'MOD_RSFT' }
+};
+
+/**
+ * Get the QMK keycode for a label, as typed with an output profile
+ * Letters, digits, keypad (KP_1) and function keys (F1) are recognised by name.
+ * Compose sequences are COMPOSED(COMPOSE_<name>). Returns KC_NO for labels
+ * only other profiles can type, and null for labels no profile knows.
+ */
+function keycodeForLabel(label, profile = DEFAULT_PROFILE) {
+  const labels = OUTPUT_PROFILES[profile].labels;
+  if (Object.prototype.hasOwnProperty.call(labels, label)) {
+    const keycode = labels[label];
+    return typeof keycode === 'object' ? `COMPOSED(COMPOSE_${keycode.compose})` : keycode;
+  }
+  if (Object.prototype.hasOwnProperty.call(LABEL_KEYCODES, label)) {
+    return LABEL_KEYCODES[label];
+  }
+  if (/^[a-z0-9]$/.test(label)) {
+    return `KC_${label.toUpperCase()}`;
+  }
+  if (/^[A-Z]$/.test(label)) {
+    return `LSFT(KC_${label})`;
+  }
+  if (/^(KP_[0-9]|F[0-9]{1,2})$/.test(label)) {
+    return `KC_${label}`;
+  }
+  if (Object.values(OUTPUT_PROFILES).some(other => Object.prototype.hasOwnProperty.call(other.labels, label))) {
+    return 'KC_NO';
+  }
+  return null;
+}
+
+/**
+ * Keycode aliases an output profile's labels use, for keymap_tables_<profile>.h
+ */
+function profileAliases(profile) {
+  return { ...COMMON_ALIASES, ...OUTPUT_PROFILES[profile].aliases };
+}
+
+/**
+ * Compose sequences of an output profile, in the order they were defined
+ */
+function composeSequences(profile) {
+  return Object.values(OUTPUT_PROFILES[profile].labels).filter(keycode => typeof keycode === 'object');
+}
+
+/**
+ * Get the label a key shows with Shift held
+ */
+function shiftedLabel(label) {
+  if (/^[a-z]$/.test(label)) {
+    return label.toUpperCase();
+  }
+  return SHIFTED_LABELS[label] || null;
+}
+
+module.exports = { LABEL_KEYCODES, OUTPUT_PROFILES, DEFAULT_PROFILE, HOLD_MODS, keycodeForLabel, profileAliases, composeSequences, shiftedLabel };
@@ -0,0 +1,210 @@
+#!/usr/bin/env node
+
+/**
+ * Draw key usage counts as a heatmap of layout.yaml
+ *
+ * Build the keymap with USAGE_STATS_ENABLE=yes, use it for a while, then
+ * capture the console until the next save (after 5 seconds idle) and draw it:
+ *
+ *   qmk compile -kb ferris/sweep -km qwerty -e USAGE_STATS_ENABLE=yes
+ *   qmk console > usage.txt
+ *   node scripts/usage-heatmap.js usage.txt > heatmap.yaml
+ *   keymap draw heatmap.yaml -o heatmap.svg
+ *
+ * The output is layout.yaml with only the real layers, each key labelled
+ * with its press count and shaded by how often it is used, on a log scale.
+ * A summary of layer entries and symbol override hits goes to stderr. Pass the
+ * --profile the firmware was built with, as each has its own overrides.
+ */
+
+const fs = require('fs');
+const path = require('path');
+const { MATRIX_LAYOUTS, parseLayers, buildSymbolRows, collectOverrides } = require('./generate-keymap');
+const { OUTPUT_PROFILES, DEFAULT_PROFILE } = require('./keymap-labels');
+
+// Try to require js-yaml from website/node_modules when run from website/
+let yaml;
+try {
+  yaml = require('js-yaml');
+} catch (error) {
+  // If not found, try from website/node_modules (when run from root)
+  const yamlPath = path.join(__dirname, '..', 'website', 'node_modules', 'js-yaml');
+  yaml = require(yamlPath);
+}
+
+// Shades from unused to most used
+const HEAT_COLORS = ['#fff5f0', '#fee0d2', '#fcbba1', '#fc9272', '#fb6a4a', '#ef3b2c', '#cb181d', '#a50f15', '#67000d'];
+
+/**
+ * Read the totals of the last complete save from console output
+ * Each save lists every non-zero total between "usage start" and "usage end"
+ */
+function parseConsole(text) {
+  let snapshot = null;
+  let current = null;
+
+  for (const line of text.split('\n')) {
+    if (/usage start/.test(line)) {
+      current = { keys: [], overrides: new Map() };
+      continue;
+    }
+    if (!current) {
+      continue;
+    }
+    if (/usage end/.test(line)) {
+      snapshot = current;
+      current = null;
+      continue;
+    }
+
+    let match = line.match(/usage k (\d+) (\d+) (\d+) (\d+)/);
+    if (match) {
+      const [layer, row, col, total] = match.slice(1).map(Number);
+      current.keys.push({ layer, row, col, total });
+      continue;
+    }
+    match = line.match(/usage o (\d+) (\d+)/);
+    if (match) {
+      current.overrides.set(Number(match[1]), Number(match[2]));
+    }
+  }
+
+  return snapshot;
+}
+
+/**
+ * Press counts for each position of each real layer, in layout.yaml order
+ */
+function layerCounts(snapshot, layers, matrix) {
+  const counts = layers.map(layer => new Array(layer.keys.length).fill(0));
+  for (const { layer, row, col, total } of snapshot.keys) {
+    if (layer < counts.length) {
+      counts[layer][matrix.position(row, col)] = total;
+    }
+  }
+  return counts;
+}
+
+/**
+ * Shade of a count, from 1 to HEAT_COLORS.length - 1 on a log scale (0 is unused)
+ */
+function heatLevel(count, max) {
+  if (count === 0) {
+    return 0;
+  }
+  const top = HEAT_COLORS.length - 1;
+  return Math.max(1, Math.ceil(top * Math.log(count + 1) / Math.log(max + 1)));
+}
+
+/**
+ * Build the keymap-drawer YAML for the heatmap
+ */
+function buildHeatmap(layoutData, layers, counts) {
+  const max = Math.max(1, ...counts.flat());
+  const heatmap = {
+    layout: layoutData.layout,
+    draw_config: {
+      svg_extra_style: HEAT_COLORS.map((color, level) => `rect.heat${level} { fill: ${color}; }`).join('\n')
+    },
+    layers: {}
+  };
+
+  layers.forEach((layer, index) => {
+    const rows = layoutData.layers[layer.name];
+    let position = 0;
+    heatmap.layers[layer.name] = rows.map(row => row.map(keyDef => {
+      const count = counts[index][position++];
+      const key = keyDef && typeof keyDef === 'object' ? { ...keyDef } : { t: keyDef ?? '' };
+      key.type = `heat${heatLevel(count, max)}`;
+      if (count > 0) {
+        key.s = String(count);
+      }
+      return key;
+    }));
+  });
+
+  return heatmap;
+}
+
+/**
+ * Print how often each layer was entered, and which overrides were hit
+ */
+function printSummary(snapshot, layers, counts, overrideNames) {
+  const entries = new Map();
+  layers.forEach((layer, index) => {
+    layer.keys.forEach((key, position) => {
+      const target = key.keycode.match(/^TO\((\w+)\)$/);
+      if (target && counts[index][position] > 0) {
+        entries.set(target[1], (entries.get(target[1]) || 0) + counts[index][position]);
+      }
+    });
+  });
+
+  console.error('Layer   presses  entered');
+  layers.forEach((layer, index) => {
+    const presses = counts[index].reduce((sum, count) => sum + count, 0);
+    console.error(`${layer.name.padEnd(7)} ${String(presses).padStart(7)}  ${String(entries.get(layer.name) || 0).padStart(7)}`);
+  });
+
+  const hits = Array.from(snapshot.overrides.entries())
+    .map(([id, total]) => ({ name: overrideNames[id] || `override ${id}`, total }))
+    .sort((a, b) => b.total - a.total);
+  console.error(`\nSymbol overrides hit (${hits.length} of ${overrideNames.length - 1}):`);
+  hits.forEach(({ name, total }) => console.error(`${String(total).padStart(7)}  ${name}`));
+
+  const unused = overrideNames.filter((name, id) => id > 0 && !snapshot.overrides.has(id) && !name.includes('BLOCKED'));
+  if (unused.length > 0) {
+    console.error(`\nNever hit: ${unused.join(', ')}`);
+  }
+}
+
+/**
+ * Main function
+ */
+function main() {
+  const args = process.argv.slice(2);
+  const option = (name, fallback) => {
+    const idx = args.indexOf(name);
+    return idx === -1 ? fallback : args.splice(idx, 2)[1];
+  };
+  const layoutPath = option('--layout', path.join(__dirname, '..', 'keyboards', 'ferris', 'sweep', 'keymaps', 'qwerty', 'layout.yaml'));
+  const profile = option('--profile', DEFAULT_PROFILE);
+
+  if (!args[0]) {
+    console.error('Usage: usage-heatmap.js <console output> [--layout layout.yaml] [--profile name]');
+    process.exit(1);
+  }
+  if (!OUTPUT_PROFILES[profile]) {
+    console.error(`Unknown output profile ${profile}: use one of ${Object.keys(OUTPUT_PROFILES).join(', ')}`);
+    process.exit(1);
+  }
+
+  const snapshot = parseConsole(fs.readFileSync(args[0], 'utf8'));
+  if (!snapshot) {
+    console.error('No usage counts found. Was the keymap built with USAGE_STATS_ENABLE=yes, and was the console captured until "usage end"?');
+    process.exit(1);
+  }
+
+  const layoutData = yaml.load(fs.readFileSync(layoutPath, 'utf8'));
+  const matrix = MATRIX_LAYOUTS[layoutData.layout.layout_name];
+  if (!matrix) {
+    throw new Error(`Unknown matrix for ${layoutData.layout.layout_name}`);
+  }
+
+  // Real layers are numbered in layout.yaml order, as in the generated tables,
+  // and overrides in the profile's enum symbol_override order
+  const allLayers = parseLayers(layoutData, profile);
+  const layers = allLayers.filter(layer => layer.real);
+  const overrideNames = ['NO_OVERRIDE', ...collectOverrides(buildSymbolRows(allLayers, profile)).overrides.keys()];
+
+  const counts = layerCounts(snapshot, layers, matrix);
+  console.log(yaml.dump(buildHeatmap(layoutData, layers, counts), { flowLevel: 3 }));
+  printSummary(snapshot, layers, counts, overrideNames);
+}
+
+// Run if executed directly
+if (require.main === module) {
+  main();
+}
+
+module.exports = { parseConsole, layerCounts, buildHeatmap };
@@ -0,0 +1,94 @@
+// Cost of finding a key's symbol override, stock linear scan against the
+// dispatch table (see stock_overrides.h), over the key presses of a text
+//
+//   bench <text>
+//
+// Counts TSC cycles on x86, nanoseconds elsewhere. Host figures compare the
+// two searches; they don't predict cycle counts on the keyboard's AVR.
+#include <stdlib.h>
+
+#include "keymap_host.h"
+#include "stock_overrides.h"
+#include "ticks.h"
+
+#define PRESSES_MAX 8192
+#define ROUNDS 200
+
+typedef struct {
+    uint16_t keycode;
+    uint8_t  mods;
+} lookup_t;
+
+static lookup_t lookups[PRESSES_MAX];
+static int      lookup_count;
+
+// Letters, space and '.' as typed; capitals with Shift. Every 8th letter is
+// typed with Alt and every 32nd with Shift+Alt, for a symbol-heavy mix.
+static int read_text(const char *path) {
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        return -1;
+    }
+    int c;
+    while ((c = fgetc(file)) != EOF && lookup_count < PRESSES_MAX) {
+        lookup_t lookup = {.mods = 0};
+        if (c >= 'A' && c <= 'Z') {
+            lookup.mods = MOD_BIT_LSHIFT;
+            c += 'a' - 'A';
+        }
+        if (c >= 'a' && c <= 'z') {
+            lookup.keycode = KC_A + c - 'a';
+        } else if (c == '.' || c == ',') {
+            lookup.keycode = KC_DOT;
+        } else if (c == ' ' || c == '\n') {
+            lookup.keycode = KC_SPACE;
+        } else {
+            continue;
+        }
+        if (lookup_count % 32 == 31) {
+            lookup.mods |= MOD_BIT_LALT | MOD_BIT_LSHIFT;
+        } else if (lookup_count % 8 == 7) {
+            lookup.mods |= MOD_BIT_LALT;
+        }
+        lookups[lookup_count++] = lookup;
+    }
+    fclose(file);
+    return lookup_count;
+}
+
+static uint64_t time_lookups(uint8_t (*lookup)(uint16_t, uint8_t, uint8_t), unsigned *hits) {
+    uint64_t best = UINT64_MAX;
+    for (int round = 0; round < ROUNDS; round++) {
+        unsigned found = 0;
+        uint64_t start = ticks();
+        for (int i = 0; i < lookup_count; i++) {
+            found += lookup(lookups[i].keycode, lookups[i].mods, BASE) != NO_OVERRIDE;
+        }
+        uint64_t elapsed = ticks() - start;
+        best             = elapsed < best ? elapsed : best;
+        *hits            = found;
+    }
+    return best;
+}
+
+int main(int argc, char **argv) {
+    if (argc != 2 || read_text(argv[1]) <= 0) {
+        fprintf(stderr, "usage: bench <text>\n");
+        return 2;
+    }
+    host_reset();
+    build_stock_overrides();
+
+    unsigned stock_hits, dispatch_hits;
+    uint64_t stock    = time_lookups(stock_lookup, &stock_hits);
+    uint64_t dispatch = time_lookups(dispatch_lookup, &dispatch_hits);
+    if (stock_hits != dispatch_hits) {
+        fprintf(stderr, "bench: the searches disagree (%u and %u hits)\n", stock_hits, dispatch_hits);
+        return 1;
+    }
+
+    printf("%d presses, %u symbols, %u overrides in the flat list (%s)\n", lookup_count, stock_hits, stock_override_count, KEYMAP_TABLES);
+    printf("linear scan  %6.1f %s per press\n", (double)stock / lookup_count, TICKS);
+    printf("dispatch     %6.1f %s per press\n", (double)dispatch / lookup_count, TICKS);
+    return 0;
+}
@@ -0,0 +1,128 @@
+// Cost of process_record_user() on the key presses and releases of a text
+//
+//   bench_record <text>
+//
+// Only calls keymap.c's own entry point, so it builds against older copies of
+// the keymap too (make bench-record KEYMAP_DIR=...) and the two can be
+// compared. Counts TSC cycles on x86, nanoseconds elsewhere; host figures
+// don't predict cycle counts on the keyboard's AVR.
+#include <stdlib.h>
+
+#include "keymap_host.h"
+#include "ticks.h"
+
+#define EVENTS_MAX 16384
+#define ROUNDS 2000
+
+typedef struct {
+    keyrecord_t record;
+    uint8_t     mods;
+    uint8_t     oneshot_mods;
+} record_event_t;
+
+static record_event_t events[EVENTS_MAX];
+static int            event_count;
+static unsigned       alt_presses;
+
+static bool find_key(uint16_t keycode, keyrecord_t *record) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            uint16_t key = keycode_at_keymap_location(BASE, row, col);
+            if (key == keycode || (IS_QK_MOD_TAP(key) && QK_MOD_TAP_GET_TAP_KEYCODE(key) == keycode)) {
+                record->keycode   = key;
+                record->event.key = (keypos_t){.row = row, .col = col};
+                record->tap.count = IS_QK_MOD_TAP(key) ? 1 : 0;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Letters, space and '.' as typed, as a press and a release each. Capitals
+// and ',' (Shift+.) with one-shot Shift; every 24th letter with Alt held, for
+// the Alt symbols of ordinary text.
+static int read_text(const char *path) {
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        return -1;
+    }
+    int      c;
+    unsigned letters = 0;
+    while ((c = fgetc(file)) != EOF && event_count + 2 <= EVENTS_MAX) {
+        record_event_t press = {.mods = 0};
+        if (c >= 'A' && c <= 'Z') {
+            press.oneshot_mods = MOD_BIT_LSHIFT;
+            c += 'a' - 'A';
+        } else if (c == ',') {
+            press.oneshot_mods = MOD_BIT_LSHIFT;
+            c = '.';
+        }
+        uint16_t keycode;
+        if (c >= 'a' && c <= 'z') {
+            keycode = KC_A + c - 'a';
+            if (++letters % 24 == 0) {
+                press.mods = MOD_BIT_LALT;
+                alt_presses++;
+            }
+        } else if (c == '.') {
+            keycode = KC_DOT;
+        } else if (c == ' ' || c == '\n') {
+            keycode = KC_SPACE;
+        } else {
+            continue;
+        }
+        if (!find_key(keycode, &press.record)) {
+            continue;
+        }
+        record_event_t release = press;
+        press.record.event.pressed   = true;
+        release.record.event.pressed = false;
+        release.oneshot_mods         = 0;
+        events[event_count++]        = press;
+        events[event_count++]        = release;
+    }
+    fclose(file);
+    return event_count;
+}
+
+// One pass over the events, best of ROUNDS. Without process_record_user() it
+// times the rest of the loop, which is subtracted.
+static uint64_t time_events(bool call) {
+    uint64_t best = UINT64_MAX;
+    for (int round = 0; round < ROUNDS; round++) {
+        host_reset();
+        uint64_t start = ticks();
+        for (int i = 0; i < event_count; i++) {
+            keyrecord_t record = events[i].record;
+            set_mods(events[i].mods);
+            if (events[i].oneshot_mods) {
+                set_oneshot_mods(events[i].oneshot_mods);
+            }
+            if (call) {
+                process_record_user(record.keycode, &record);
+            }
+            if (!record.event.pressed) {
+                clear_mods();
+                clear_oneshot_mods();
+            }
+        }
+        uint64_t elapsed = ticks() - start;
+        best             = elapsed < best ? elapsed : best;
+    }
+    return best;
+}
+
+int main(int argc, char **argv) {
+    if (argc != 2 || read_text(argv[1]) <= 0) {
+        fprintf(stderr, "usage: bench_record <text>\n");
+        return 2;
+    }
+
+    uint64_t loop  = time_events(false);
+    uint64_t total = time_events(true);
+
+    printf("%d events, %u with Alt held (%s)\n", event_count, alt_presses, KEYMAP_TABLES);
+    printf("process_record_user  %6.1f %s per event\n", (double)(total > loop ? total - loop : 0) / event_count, TICKS);
+    return 0;
+}
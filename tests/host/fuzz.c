@@ -0,0 +1,621 @@
+// Random key sequences through keymap.c, checked against a stock QMK setup of
+// the same symbols and against invariants of its own
+//
+//   fuzz [-s seed] [-n runs] [-e events]   random sequences
+//   fuzz [-v] <trace>                      check one trace, -v printing
+//                                          the reports of both runs
+//
+// Each sequence presses and releases random keys, with the gaps between
+// events picked around TAPPING_TERM, FLOW_TAP_TERM and COMBO_TERM as well as
+// short and long ones, so one-shot mods, mod-taps, combos and layer keys race
+// each other. It is run twice:
+//
+// - through keymap.c as built, and
+// - through a reference: the symbol table as one flat key_overrides[] list
+//   the engine scans (stock_overrides.h), which also matches tapped mod-taps
+//   and has the repeat key remember what an override typed. That is what
+//   process_symbols() stands in for, so the two must type the same.
+//
+// The key presses sent, the layer and, between overrides, the mods and
+// one-shot mods must match after every event. keymap.c's run is also checked
+// for keys or mods still held once every key is up (unless the reference
+// leaves them held too), for the repeat key typing something other than what
+// was typed last, and for one-shot mods dropped without being sent. A failing
+// sequence is cut down to a minimal one that fails the same way, and printed
+// as a trace for keysim -r.
+#include <stdlib.h>
+
+#include "keymap_host.h"
+#include "stock_overrides.h"
+
+#define EVENTS_MAX 512
+#define HELD_MAX 4
+
+// The reference configuration's hooks
+
+// A stock keymap's process_record_user() only has to type Compose sequences.
+// The engine leaves the override's suppressed mods out of reports, which would
+// take the sequence's own Shift off as well, so they are lifted instead.
+static bool stock_process_record(uint16_t keycode, keyrecord_t *record) {
+    if (IS_COMPOSED(keycode)) {
+        if (record->event.pressed) {
+            uint8_t suppressed = host_active_override != NULL ? host_active_override->suppressed_mods : 0;
+            uint8_t mods       = get_mods();
+            uint8_t weak_mods  = get_weak_mods();
+            clear_suppressed_override_mods();
+            del_mods(suppressed);
+            del_weak_mods(suppressed);
+            tap_composed(keycode);
+            set_mods(mods);
+            set_weak_mods(weak_mods);
+            set_suppressed_override_mods(suppressed);
+        }
+        return false;
+    }
+    return true;
+}
+
+// keymap.c's state that host_reset() doesn't know about
+static void reset_keymap(void) {
+    active_symbol_row  = NO_SYMBOLS;
+    symbol_cache_page  = 0;
+    symbol_cache_count = 0;
+    recent_press_head  = 0;
+    memset(recent_presses, 0, sizeof(recent_presses));
+    symbol_in_engine   = false;
+}
+
+// One run
+
+typedef struct {
+    uint32_t presses; // key presses sent so far
+    uint8_t  layer;
+    uint8_t  mods;
+    uint8_t  oneshot_mods;
+    bool     overriding; // an override is active, and mods can differ
+} snapshot_t;
+
+// A key press as it reached the keymap, and the key presses sent until the
+// next one
+typedef struct {
+    uint16_t keycode;
+    bool     tapped;
+    uint8_t  layer;
+    uint8_t  mods;        // real, weak and one-shot
+    uint8_t  engine_mods; // real and one-shot, which overrides match
+    uint8_t  oneshot_mods;
+    bool     alone;     // no other key was held
+    bool     keys_down; // the last report had a key in it
+    // An override was active: QMK remembers the key for repeat before the
+    // engine puts back the mods the override lifted
+    bool     overridden;
+    uint32_t first_press;
+} group_t;
+
+typedef struct {
+    snapshot_t    snapshots[EVENTS_MAX + 1];
+    host_press_t  presses[HOST_REPORT_LOG];
+    uint32_t      press_count;
+    host_report_t reports[HOST_REPORT_LOG];
+    uint32_t      report_count;
+    int           comparable; // events before the runs may part ways
+} run_t;
+
+static run_t    runs[2];
+static run_t   *run_now;
+static bool     remembered_lifted; // the key repeat remembers came while mods were lifted
+static uint16_t remembered_key;    // and which key that was
+static uint8_t  repeat_mods;       // weak mods the held repeat key added
+static uint8_t  leaked_mods;       // weak mods the repeat key left behind
+static bool (*process_record_inner)(uint16_t keycode, keyrecord_t *record);
+static bool     checking;
+static uint32_t group_serial;
+static group_t  group;
+static group_t  last_typed; // the last group other than the repeat key's that sent key presses
+static uint32_t last_typed_count;
+static bool     group_open;
+static bool     held[MATRIX_ROWS][MATRIX_COLS];
+static int      held_count;
+static int      event_index;
+static char     failure[512];
+
+static void fail(const char *kind, const char *detail) {
+    if (failure[0] == '\0') {
+        snprintf(failure, sizeof(failure), "%s: %s (event %d)", kind, detail, event_index);
+    }
+}
+
+static uint32_t read_presses(run_t *run) {
+    run->press_count = host_presses(run->presses, ARRAY_SIZE(run->presses));
+    return run->press_count;
+}
+
+static bool same_presses(const host_press_t *a, const host_press_t *b, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        if (a[i].mods != b[i].mods || a[i].key != b[i].key) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Whether the last report has this key down, or any key for KC_NO
+static bool report_has(uint8_t key) {
+    if (host_report_total == 0) {
+        return false;
+    }
+    const host_report_t *report = &host_reports[(host_report_total - 1) % HOST_REPORT_LOG];
+    for (uint8_t i = 0; i < 6; i++) {
+        if (report->keys[i] != KC_NO && (key == KC_NO || report->keys[i] == key)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// The override the reference would activate for this press, or NO_OVERRIDE
+static uint8_t override_for(const group_t *press) {
+    uint16_t trigger = press->keycode;
+    if (IS_QK_MOD_TAP(trigger)) {
+        trigger = QK_MOD_TAP_GET_TAP_KEYCODE(trigger);
+    }
+    if (symbol_row_for(trigger) == NO_SYMBOLS) {
+        return NO_OVERRIDE;
+    }
+    return stock_lookup(trigger, press->engine_mods, press->layer);
+}
+
+// The mods an override would lift from this press
+static uint8_t suppressed_by(const group_t *press) {
+    uint8_t override = override_for(press);
+    return override == NO_OVERRIDE ? 0 : symbol_overrides[override].suppressed_mods;
+}
+
+// Whether this press types a Compose sequence, itself or through an override
+static bool types_composed(const group_t *press) {
+    uint8_t override = override_for(press);
+    return IS_COMPOSED(press->keycode) || (override != NO_OVERRIDE && IS_COMPOSED(symbol_overrides[override].replacement));
+}
+
+static bool sends_keys(uint16_t keycode, bool tapped) {
+    if (IS_QK_MOD_TAP(keycode)) {
+        return tapped;
+    }
+    return keycode != KC_NO && keycode != KC_TRNS && !IS_QK_ONE_SHOT_MOD(keycode) && !IS_QK_TO(keycode) && !IS_MODIFIER_KEYCODE(keycode);
+}
+
+// Checks on the key presses one group sent, once the next has started
+static void close_group(run_t *run) {
+    if (!group_open) {
+        return;
+    }
+    group_open                = false;
+    uint32_t            count = read_presses(run) - group.first_press;
+    const host_press_t *sent  = &run->presses[group.first_press];
+
+    // Repeat on its own, with no mods, types what was typed last. A report
+    // holds each key once, so only typing with no other key down is known
+    // press for press.
+    if (group.keycode == QK_REPEAT_KEY && group.alone && !group.keys_down && group.mods == 0 && last_typed_count > 0 && !last_typed.overridden && !last_typed.keys_down) {
+        if (count != last_typed_count || !same_presses(sent, &run->presses[last_typed.first_press], count)) {
+            char detail[128];
+            snprintf(detail, sizeof(detail), "sent %u presses, %02X+%02X first, after %u presses, %02X+%02X first", count, count ? sent[0].mods : 0, count ? sent[0].key : 0, last_typed_count, run->presses[last_typed.first_press].mods, run->presses[last_typed.first_press].key);
+            fail("repeat", detail);
+        }
+    }
+
+    // One-shot mods go out with the key, unless an override lifts them or it
+    // types a Compose sequence, which uses them up (tap_composed())
+    if (group.oneshot_mods && group.keycode != QK_REPEAT_KEY && sends_keys(group.keycode, group.tapped) && !types_composed(&group)) {
+        uint8_t expected = group.oneshot_mods & ~suppressed_by(&group);
+        uint8_t kept     = count > 0 ? sent[0].mods : get_oneshot_mods();
+        if ((kept & expected) != expected) {
+            char detail[96];
+            snprintf(detail, sizeof(detail), "one-shot %02X on 0x%04X, %02X %s", expected, group.keycode, kept, count > 0 ? "sent" : "left");
+            fail("one-shot", detail);
+        }
+    }
+
+    // Repeating doesn't change what the repeat key remembers. A key pressed
+    // while another is down can send no new press, and then what it sent
+    // isn't known.
+    if (group.keycode != QK_REPEAT_KEY && (count > 0 || (group.keys_down && sends_keys(group.keycode, group.tapped)))) {
+        last_typed       = group;
+        last_typed_count = count;
+    }
+}
+
+// Every key press that reaches the keymap goes through here first
+static bool track_process_record(uint16_t keycode, keyrecord_t *record) {
+    if (checking && record->event.pressed && host_key_presses != group_serial) {
+        run_t *run = &runs[0];
+        close_group(run);
+        group_serial = host_key_presses;
+        group_open   = true;
+        group        = (group_t){
+                   .keycode      = keycode,
+                   .tapped       = record->tap.count > 0,
+                   .layer        = get_highest_layer(layer_state | default_layer_state),
+                   .mods         = get_mods() | get_weak_mods() | get_oneshot_mods(),
+                   .engine_mods  = get_mods() | get_oneshot_mods(),
+                   .oneshot_mods = get_oneshot_mods(),
+                   .alone        = held_count == 1,
+                   .keys_down    = report_has(KC_NO),
+                   .overridden   = host_active_override != NULL,
+                   .first_press  = read_presses(run),
+        };
+    }
+
+    // QMK remembers a key for repeat before the engine puts back the mods an
+    // override lifted, and keymap.c lifts none for the presses it swallows, so
+    // repeating a key pressed while an override was active can differ
+    if (record->event.pressed && get_repeat_key_count() == 0) {
+        uint16_t key = IS_QK_MOD_TAP(keycode) ? QK_MOD_TAP_GET_TAP_KEYCODE(keycode) : keycode;
+        if (keycode == QK_REPEAT_KEY) {
+            if (remembered_lifted && run_now->comparable > event_index) {
+                run_now->comparable = event_index;
+            }
+        } else if (get_last_keycode() == key) {
+            // Pressed again with nothing lifted, a blocked key leaves the
+            // memory of the earlier press
+            remembered_lifted = host_active_override != NULL || (remembered_lifted && remembered_key == key);
+            remembered_key    = key;
+        }
+    }
+
+    // A report holds a key once, so with the keycode already down for another
+    // key (the repeat key, say) the two runs can let go of it differently
+    if (record->event.pressed) {
+        uint16_t basic = IS_QK_MOD_TAP(keycode) ? QK_MOD_TAP_GET_TAP_KEYCODE(keycode) : keycode;
+        if (basic <= QK_MODS_MAX && report_has(QK_MODS_GET_BASIC_KEYCODE(basic)) && run_now->comparable > event_index) {
+            run_now->comparable = event_index;
+        }
+    }
+
+    // QMK's repeat key takes off the mods remembered when it is released, not
+    // the ones it added, so a key remembered while it is held leaves weak mods
+    // on, and the runs can differ from then on
+    if (keycode == QK_REPEAT_KEY && get_repeat_key_count() == 0) {
+        if (record->event.pressed) {
+            repeat_mods = get_last_mods();
+        } else if (repeat_mods & ~get_last_mods() & ~leaked_mods) {
+            leaked_mods |= repeat_mods & ~get_last_mods();
+            if (run_now->comparable > event_index + 1) {
+                run_now->comparable = event_index + 1;
+            }
+        }
+    }
+    return process_record_inner(keycode, record);
+}
+
+static snapshot_t snapshot(run_t *run) {
+    return (snapshot_t){
+        .presses      = read_presses(run),
+        .layer        = get_highest_layer(layer_state | default_layer_state),
+        .mods         = get_mods(),
+        .oneshot_mods = get_oneshot_mods(),
+        .overriding   = host_active_override != NULL,
+    };
+}
+
+// Nothing held once every key is up
+static void check_released(void) {
+    if (get_mods() || (get_weak_mods() & ~leaked_mods)) {
+        char detail[64];
+        snprintf(detail, sizeof(detail), "mods %02X, weak mods %02X with every key up", get_mods(), get_weak_mods());
+        fail("stuck mods", detail);
+    }
+    if (report_has(KC_NO) || host_active_override != NULL) {
+        fail("stuck key", "a key is still down with every key up");
+    }
+}
+
+static void run_events(const host_event_t *events, int count, bool stock) {
+    run_t *run = &runs[stock];
+    run_now           = run;
+    run->comparable   = count + 1;
+    remembered_lifted = false;
+    remembered_key    = KC_NO;
+    repeat_mods       = 0;
+    leaked_mods       = 0;
+    host_reset();
+    reset_keymap();
+    if (stock) {
+        host_hooks = (host_hooks_t){
+            .process_record     = stock_process_record,
+            .override_count     = stock_key_override_count,
+            .override_get       = stock_key_override_get,
+            .match_mod_taps     = true,
+            .remember_overrides = true,
+        };
+    }
+    process_record_inner     = host_hooks.process_record;
+    host_hooks.process_record = track_process_record;
+    checking                 = !stock;
+    group_serial             = 0;
+    group_open               = false;
+    last_typed_count         = 0;
+
+    memset(held, 0, sizeof(held));
+    held_count = 0;
+    for (event_index = 0; event_index < count; event_index++) {
+        const host_event_t *event = &events[event_index];
+        if (event->time > host_time()) {
+            host_advance(event->time - host_time());
+        }
+        if (held[event->row][event->col] != event->pressed) {
+            held[event->row][event->col] = event->pressed;
+            held_count += event->pressed ? 1 : -1;
+        }
+        host_key_event(event->row, event->col, event->pressed);
+
+        run->snapshots[event_index] = snapshot(run);
+        if (held_count == 0) {
+            check_released();
+        }
+    }
+    host_release_all();
+    run->snapshots[count] = snapshot(run);
+    run->report_count     = host_report_count;
+    memcpy(run->reports, host_reports, sizeof(host_report_t) * host_report_count);
+    if (checking) {
+        close_group(run);
+    }
+    check_released();
+}
+
+// Runs both and returns why they fail, or NULL
+static const char *check(const host_event_t *events, int count) {
+    char keymap_failure[sizeof(failure)];
+    failure[0] = '\0';
+    run_events(events, count, false);
+    strcpy(keymap_failure, failure);
+    failure[0] = '\0';
+    run_events(events, count, true);
+
+    // Keys or mods stock QMK leaves down in the same way are QMK's own, such
+    // as the repeat key releasing the mods of a key pressed while it is held
+    if (keymap_failure[0] != '\0' && strcmp(keymap_failure, failure) != 0) {
+        strcpy(failure, keymap_failure);
+        return failure;
+    }
+    failure[0] = '\0';
+
+    const run_t *keymap = &runs[0], *stock = &runs[1];
+    int          compared = keymap->comparable < stock->comparable ? keymap->comparable : stock->comparable;
+    for (event_index = 0; event_index < compared; event_index++) {
+        const snapshot_t *a = &keymap->snapshots[event_index], *b = &stock->snapshots[event_index];
+        char              detail[128];
+        if (a->presses != b->presses || !same_presses(keymap->presses, stock->presses, a->presses)) {
+            uint32_t first = 0;
+            while (first < a->presses && first < b->presses && keymap->presses[first].mods == stock->presses[first].mods && keymap->presses[first].key == stock->presses[first].key) {
+                first++;
+            }
+            snprintf(detail, sizeof(detail), "press %u is %02X+%02X, stock QMK sends %02X+%02X", first, first < a->presses ? keymap->presses[first].mods : 0, first < a->presses ? keymap->presses[first].key : 0, first < b->presses ? stock->presses[first].mods : 0, first < b->presses ? stock->presses[first].key : 0);
+            fail("presses", detail);
+            return failure;
+        }
+        if (a->layer != b->layer) {
+            snprintf(detail, sizeof(detail), "layer %u, stock QMK is on %u", a->layer, b->layer);
+            fail("layer", detail);
+            return failure;
+        }
+        if (!a->overriding && !b->overriding && (a->mods != b->mods || a->oneshot_mods != b->oneshot_mods)) {
+            snprintf(detail, sizeof(detail), "mods %02X one-shot %02X, stock QMK has %02X one-shot %02X", a->mods, a->oneshot_mods, b->mods, b->oneshot_mods);
+            fail("mods", detail);
+            return failure;
+        }
+    }
+    return NULL;
+}
+
+// Random sequences
+
+static uint32_t rng = 1;
+
+static uint32_t random_below(uint32_t n) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng % n;
+}
+
+static keypos_t keys[MATRIX_ROWS * MATRIX_COLS * 4];
+static int      key_count;
+
+// Every key that does something on some layer; one-shot, mod-tap, layer and
+// repeat keys several times over, so they come up often
+static void find_keys(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            int copies = 0;
+            for (uint8_t layer = 0; layer < LAYER_COUNT; layer++) {
+                uint16_t keycode = keycode_at_keymap_location(layer, row, col);
+                if (keycode == KC_NO || keycode == KC_TRNS) {
+                    continue;
+                }
+                copies = copies > 1 ? copies : 1;
+                if (IS_QK_ONE_SHOT_MOD(keycode) || IS_QK_MOD_TAP(keycode) || IS_QK_TO(keycode) || keycode == QK_REPEAT_KEY) {
+                    copies = 4;
+                }
+            }
+            for (int i = 0; i < copies; i++) {
+                keys[key_count++] = (keypos_t){.row = row, .col = col};
+            }
+        }
+    }
+}
+
+static uint32_t random_gap(void) {
+    switch (random_below(8)) {
+        case 0:
+        case 1:
+        case 2:
+            return random_below(4);
+        case 3:
+            return TAPPING_TERM - 5 + random_below(11);
+        case 4:
+            return FLOW_TAP_TERM - 5 + random_below(11);
+        case 5:
+            return COMBO_TERM - 5 + random_below(11);
+        case 6:
+            return 10 + random_below(110);
+        default:
+            return 300 + random_below(700);
+    }
+}
+
+static int random_events(host_event_t *events, int count) {
+    keypos_t held[HELD_MAX];
+    int      held_count = 0;
+    uint32_t time       = 0;
+    for (int i = 0; i < count; i++) {
+        time += random_gap();
+        if (held_count > 0 && (held_count == HELD_MAX || random_below(2))) {
+            int release = random_below(held_count);
+            events[i]   = (host_event_t){.time = time, .row = held[release].row, .col = held[release].col, .pressed = false};
+            held[release] = held[--held_count];
+            continue;
+        }
+        keypos_t key;
+        bool     down;
+        do {
+            key  = keys[random_below(key_count)];
+            down = false;
+            for (int h = 0; h < held_count; h++) {
+                down |= KEYEQ(held[h], key);
+            }
+        } while (down);
+        held[held_count++] = key;
+        events[i]          = (host_event_t){.time = time, .row = key.row, .col = key.col, .pressed = true};
+    }
+    return count;
+}
+
+// Minimising (ddmin): drop ever smaller chunks of the sequence while it still
+// fails the same way
+
+static bool same_failure(const char *expected, const char *got) {
+    return got != NULL && strncmp(expected, got, strcspn(expected, ":")) == 0;
+}
+
+static int minimize(host_event_t *events, int count, const char *kind) {
+    static host_event_t candidate[EVENTS_MAX];
+    int                 chunks = 2;
+    while (count >= 2) {
+        int  size    = (count + chunks - 1) / chunks;
+        bool reduced = false;
+        for (int start = 0; start < count; start += size) {
+            int length = 0;
+            for (int i = 0; i < count; i++) {
+                if (i < start || i >= start + size) {
+                    candidate[length++] = events[i];
+                }
+            }
+            if (same_failure(kind, check(candidate, length))) {
+                memcpy(events, candidate, sizeof(host_event_t) * length);
+                count   = length;
+                chunks  = chunks > 2 ? chunks - 1 : 2;
+                reduced = true;
+                break;
+            }
+        }
+        if (!reduced) {
+            if (chunks >= count) {
+                break;
+            }
+            chunks = chunks * 2 < count ? chunks * 2 : count;
+        }
+    }
+    return count;
+}
+
+static void print_presses(const char *name, const run_t *run) {
+    printf("# %-8s", name);
+    for (uint32_t i = 0; i < run->press_count; i++) {
+        printf(" %02X+%02X", run->presses[i].mods, run->presses[i].key);
+    }
+    printf("\n");
+}
+
+static void report(const host_event_t *events, int count, const char *reason) {
+    static host_event_t minimal[EVENTS_MAX];
+    char                kind[sizeof(failure)];
+    snprintf(kind, sizeof(kind), "%s", reason);
+    memcpy(minimal, events, sizeof(host_event_t) * count);
+    int length = minimize(minimal, count, kind);
+
+    printf("# %s\n", check(minimal, length));
+    print_presses("keymap", &runs[0]);
+    print_presses("stock", &runs[1]);
+    host_write_trace(stdout, minimal, length);
+}
+
+static void print_reports(const char *name, const run_t *run) {
+    printf("# %s reports\n", name);
+    for (uint32_t i = 0; i < run->report_count; i++) {
+        const host_report_t *report = &run->reports[i];
+        printf("# %6u mods %02X keys %02X %02X %02X %02X %02X %02X\n", report->time, report->mods, report->keys[0], report->keys[1], report->keys[2], report->keys[3], report->keys[4], report->keys[5]);
+    }
+}
+
+static host_event_t events[EVENTS_MAX];
+
+int main(int argc, char **argv) {
+    uint32_t seed        = 1;
+    int      run_count   = 1000;
+    int      event_count = 60;
+    bool     verbose     = false;
+    int      arg         = 1;
+    for (; arg < argc && argv[arg][0] == '-'; arg += 2) {
+        if (strcmp(argv[arg], "-v") == 0) {
+            verbose = true;
+            arg--;
+        } else if (arg + 1 == argc) {
+            break;
+        } else if (strcmp(argv[arg], "-s") == 0) {
+            seed = strtoul(argv[arg + 1], NULL, 10);
+        } else if (strcmp(argv[arg], "-n") == 0) {
+            run_count = atoi(argv[arg + 1]);
+        } else if (strcmp(argv[arg], "-e") == 0) {
+            event_count = atoi(argv[arg + 1]);
+        } else {
+            break;
+        }
+    }
+    if (arg < argc - 1 || (arg == argc - 1 && argv[arg][0] == '-') || event_count < 1 || event_count > EVENTS_MAX) {
+        fprintf(stderr, "usage: fuzz [-s seed] [-n runs] [-e events]\n       fuzz <trace>\n");
+        return 2;
+    }
+    build_stock_overrides();
+
+    if (arg == argc - 1) {
+        int count = host_read_trace(argv[arg], events, EVENTS_MAX);
+        if (count < 0) {
+            fprintf(stderr, "fuzz: can't read %s\n", argv[arg]);
+            return 2;
+        }
+        const char *reason = check(events, count);
+        if (verbose) {
+            print_reports("keymap", &runs[0]);
+            print_reports("stock", &runs[1]);
+        }
+        printf("%s %s (%s)\n", reason ? "FAIL" : "ok  ", reason ? reason : argv[arg], KEYMAP_TABLES);
+        return reason != NULL;
+    }
+
+    find_keys();
+    for (int run = 0; run < run_count; run++) {
+        rng = seed + run * 2654435761u;
+        rng = rng ? rng : 1;
+        random_events(events, event_count);
+        const char *reason = check(events, event_count);
+        if (reason != NULL) {
+            printf("FAIL seed %u run %d (%s)\n", seed, run, KEYMAP_TABLES);
+            report(events, event_count, reason);
+            return 1;
+        }
+    }
+    printf("ok   %d random sequences of %d events, seed %u (%s)\n", run_count, event_count, seed, KEYMAP_TABLES);
+    return 0;
+}
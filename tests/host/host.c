@@ -0,0 +1,890 @@
+// The parts of QMK's core keymap.c runs inside, for the host (see host.h and
+// readme.md). Each section names the QMK code it stands in for.
+#include "host.h"
+
+// Hooks and tables keymap.c provides (see keymap_host.h for the counts)
+bool                  pre_process_record_user(uint16_t keycode, keyrecord_t *record);
+bool                  process_record_user(uint16_t keycode, keyrecord_t *record);
+uint16_t              key_override_count(void);
+const key_override_t *key_override_get(uint16_t key_override_idx);
+uint16_t              get_flow_tap_term(uint16_t keycode, keyrecord_t *record, uint16_t prev_keycode);
+void                  keyboard_post_init_user(void);
+void                  housekeeping_task_user(void);
+extern const uint16_t keymaps[][MATRIX_ROWS][MATRIX_COLS];
+extern const uint8_t  host_keymap_layer_count;
+extern const char     chordal_hold_layout[MATRIX_ROWS][MATRIX_COLS];
+extern combo_t        key_combos[];
+extern const uint16_t host_combo_count;
+uint16_t              get_combo_term(uint16_t combo_index, combo_t *combo);
+bool                  combo_should_trigger(uint16_t combo_index, combo_t *combo, uint16_t keycode, keyrecord_t *record);
+
+host_report_t host_reports[HOST_REPORT_LOG];
+uint32_t      host_report_count;
+uint32_t      host_report_total;
+
+host_hooks_t          host_hooks;
+const key_override_t *host_active_override;
+uint32_t              host_override_activations;
+uint32_t              host_key_presses;
+
+layer_state_t layer_state;
+layer_state_t default_layer_state;
+
+static uint32_t now;
+static uint8_t  real_mods;
+static uint8_t  weak_mods;
+static uint8_t  oneshot_mods;
+static uint8_t  suppressed_mods;    // left out of reports while a key override is active
+static uint8_t  weak_override_mods; // added to them for its replacement
+static uint8_t  report_keys[6];
+static uint16_t last_keycode;
+static uint8_t  last_mods;
+static bool     repeating;       // the repeat key is replaying last_keycode
+static uint16_t repeated_keycode; // what the held repeat key pressed
+static int8_t   repeat_count;     // repeat key presses since the last other key
+
+// Modifiers
+
+uint8_t get_mods(void) {
+    return real_mods;
+}
+void add_mods(uint8_t mods) {
+    real_mods |= mods;
+}
+void del_mods(uint8_t mods) {
+    real_mods &= ~mods;
+}
+void set_mods(uint8_t mods) {
+    real_mods = mods;
+}
+void clear_mods(void) {
+    real_mods = 0;
+}
+uint8_t get_weak_mods(void) {
+    return weak_mods;
+}
+void add_weak_mods(uint8_t mods) {
+    weak_mods |= mods;
+}
+void del_weak_mods(uint8_t mods) {
+    weak_mods &= ~mods;
+}
+void set_weak_mods(uint8_t mods) {
+    weak_mods = mods;
+}
+uint8_t get_oneshot_mods(void) {
+    return oneshot_mods;
+}
+void add_oneshot_mods(uint8_t mods) {
+    oneshot_mods |= mods;
+}
+void del_oneshot_mods(uint8_t mods) {
+    oneshot_mods &= ~mods;
+}
+void set_oneshot_mods(uint8_t mods) {
+    oneshot_mods = mods;
+}
+void clear_oneshot_mods(void) {
+    oneshot_mods = 0;
+}
+void set_suppressed_override_mods(uint8_t mods) {
+    suppressed_mods = mods;
+}
+void clear_suppressed_override_mods(void) {
+    suppressed_mods = 0;
+}
+
+// Reports, as in QMK's action_util.c: one-shot mods go out with the next
+// report that has a key in it, and are used up by it. The mods of an active
+// key override go on last.
+
+void send_keyboard_report(void) {
+    host_report_t *report = &host_reports[host_report_count % HOST_REPORT_LOG];
+    report->time          = now;
+    report->mods          = ((real_mods | weak_mods | oneshot_mods) & ~suppressed_mods) | weak_override_mods;
+    memcpy(report->keys, report_keys, sizeof(report_keys));
+    host_report_count = host_report_count < HOST_REPORT_LOG ? host_report_count + 1 : HOST_REPORT_LOG;
+    host_report_total++;
+
+    for (uint8_t i = 0; i < sizeof(report_keys); i++) {
+        if (report_keys[i] != KC_NO) {
+            oneshot_mods = 0;
+            break;
+        }
+    }
+}
+
+static void add_key(uint8_t kc) {
+    for (uint8_t i = 0; i < sizeof(report_keys); i++) {
+        if (report_keys[i] == kc) {
+            return;
+        }
+    }
+    for (uint8_t i = 0; i < sizeof(report_keys); i++) {
+        if (report_keys[i] == KC_NO) {
+            report_keys[i] = kc;
+            return;
+        }
+    }
+}
+
+static void del_key(uint8_t kc) {
+    for (uint8_t i = 0; i < sizeof(report_keys); i++) {
+        if (report_keys[i] == kc) {
+            report_keys[i] = KC_NO;
+        }
+    }
+}
+
+// Modded keycode mods (5 bit, right-hand flag) in get_mods() format
+static uint8_t mod_config(uint8_t mods) {
+    return (mods & 0x10) ? (mods & 0x0F) << 4 : mods;
+}
+
+void register_code(uint8_t kc) {
+    if (kc == KC_NO) {
+        return;
+    }
+    if (IS_MODIFIER_KEYCODE(kc)) {
+        add_mods(MOD_BIT(kc));
+    } else {
+        add_key(kc);
+    }
+    send_keyboard_report();
+}
+
+void unregister_code(uint8_t kc) {
+    if (kc == KC_NO) {
+        return;
+    }
+    if (IS_MODIFIER_KEYCODE(kc)) {
+        del_mods(MOD_BIT(kc));
+    } else {
+        del_key(kc);
+    }
+    send_keyboard_report();
+}
+
+void tap_code(uint8_t kc) {
+    register_code(kc);
+    wait_ms(TAP_CODE_DELAY);
+    unregister_code(kc);
+}
+
+void register_code16(uint16_t kc) {
+    uint8_t mods = mod_config(QK_MODS_GET_MODS(kc));
+    if (IS_MODIFIER_KEYCODE(QK_MODS_GET_BASIC_KEYCODE(kc)) || QK_MODS_GET_BASIC_KEYCODE(kc) == KC_NO) {
+        add_mods(mods);
+    } else {
+        add_weak_mods(mods);
+    }
+    register_code(QK_MODS_GET_BASIC_KEYCODE(kc));
+}
+
+void unregister_code16(uint16_t kc) {
+    uint8_t mods = mod_config(QK_MODS_GET_MODS(kc));
+    unregister_code(QK_MODS_GET_BASIC_KEYCODE(kc));
+    if (IS_MODIFIER_KEYCODE(QK_MODS_GET_BASIC_KEYCODE(kc)) || QK_MODS_GET_BASIC_KEYCODE(kc) == KC_NO) {
+        del_mods(mods);
+    } else {
+        del_weak_mods(mods);
+    }
+    send_keyboard_report();
+}
+
+void tap_code16(uint16_t kc) {
+    register_code16(kc);
+    wait_ms(TAP_CODE_DELAY);
+    unregister_code16(kc);
+}
+
+uint32_t host_presses(host_press_t *presses, uint32_t max) {
+    uint32_t count = 0;
+    uint8_t  previous[6] = {0};
+    uint32_t first       = host_report_total - host_report_count;
+    for (uint32_t n = first; n < host_report_total; n++) {
+        const host_report_t *report = &host_reports[n % HOST_REPORT_LOG];
+        for (uint8_t i = 0; i < 6; i++) {
+            uint8_t key = report->keys[i];
+            if (key == KC_NO || memchr(previous, key, sizeof(previous))) {
+                continue;
+            }
+            if (count < max) {
+                presses[count] = (host_press_t){.time = report->time, .mods = report->mods, .key = key};
+            }
+            count++;
+        }
+        memcpy(previous, report->keys, sizeof(previous));
+    }
+    return count < max ? count : max;
+}
+
+// Repeat key memory
+
+uint16_t get_last_keycode(void) {
+    return last_keycode;
+}
+uint8_t get_last_mods(void) {
+    return last_mods;
+}
+void set_last_keycode(uint16_t keycode) {
+    last_keycode = keycode;
+}
+void set_last_mods(uint8_t mods) {
+    last_mods = mods;
+}
+__attribute__((weak)) bool remember_last_key_user(uint16_t keycode, keyrecord_t *record, uint8_t *remembered_mods) {
+    return true;
+}
+
+// As in QMK, only nonzero while the repeat key replays a key
+int8_t get_repeat_key_count(void) {
+    return repeating ? repeat_count : 0;
+}
+
+// Layers
+
+uint8_t get_highest_layer(layer_state_t state) {
+    uint8_t layer = 0;
+    while (state >>= 1) {
+        layer++;
+    }
+    return layer;
+}
+
+void layer_move(uint8_t layer) {
+    layer_state = (layer_state_t)1 << layer;
+}
+
+uint16_t keycode_at_keymap_location_raw(uint8_t layer_num, uint8_t row, uint8_t column) {
+    if (layer_num < host_keymap_layer_count && row < MATRIX_ROWS && column < MATRIX_COLS) {
+        return keymaps[layer_num][row][column];
+    }
+    return KC_NO;
+}
+
+// Weak in QMK too, so a keymap can override it
+__attribute__((weak)) uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
+    return keycode_at_keymap_location_raw(layer_num, row, column);
+}
+
+// The highest active layer whose key isn't transparent
+static uint16_t keycode_for(keypos_t key) {
+    layer_state_t layers = layer_state | default_layer_state;
+    for (int8_t layer = 31; layer >= 0; layer--) {
+        if (layers & ((layer_state_t)1 << layer)) {
+            uint16_t keycode = keycode_at_keymap_location(layer, key.row, key.col);
+            if (keycode != KC_TRNS) {
+                return keycode;
+            }
+        }
+    }
+    return KC_NO;
+}
+
+// Tap-hold hooks
+
+char chordal_hold_handedness(keypos_t key) {
+    return chordal_hold_layout[key.row][key.col];
+}
+
+// QMK's default: letters, space and the typing punctuation
+bool is_flow_tap_key(uint16_t keycode) {
+    if (IS_QK_MOD_TAP(keycode)) {
+        keycode = QK_MOD_TAP_GET_TAP_KEYCODE(keycode);
+    }
+    return (keycode >= KC_A && keycode <= KC_Z) || keycode == KC_SPACE || keycode == KC_DOT || keycode == KC_COMMA || keycode == KC_SEMICOLON || keycode == KC_SLASH;
+}
+
+// Timer and console
+
+uint16_t timer_read(void) {
+    return now;
+}
+uint32_t timer_read32(void) {
+    return now;
+}
+void wait_ms(uint16_t ms) {
+    now += ms;
+}
+
+void eeconfig_read_user_datablock(void *data, uint32_t offset, uint32_t length) {
+    memset(data, 0, length);
+}
+void eeconfig_update_user_datablock(const void *data, uint32_t offset, uint32_t length) {}
+
+bool rgblight_is_enabled(void) {
+    return false;
+}
+void rgblight_timer_enable(void) {}
+void rgblight_timer_disable(void) {}
+
+// Key override engine
+// A model of QMK's process_key_override(): on a key press, the first override
+// the engine is shown (key_override_get()) whose trigger is the key, whose
+// trigger mods are held and negative mods aren't, on an enabled layer, is
+// activated. Its suppressed mods are left out of reports, though get_mods()
+// still has them, and its replacement is registered until the trigger is
+// released or another key is pressed. Replacements that
+// aren't (modded) basic keycodes are tapped through the keymap's
+// process_record_user(). Activation by a modifier pressed after the trigger is
+// not modelled, so neither are overrides with a KC_NO trigger, which only
+// modifiers activate.
+
+static keypos_t active_trigger;
+
+static bool remembered_by_repeat(uint16_t keycode, const keyrecord_t *record);
+
+static bool override_matches(const key_override_t *override, uint16_t keycode, uint8_t mods) {
+    uint8_t held      = (mods | (mods >> 4)) & 0x0F;
+    uint8_t triggered = (override->trigger_mods | (override->trigger_mods >> 4)) & 0x0F;
+    uint8_t layer     = get_highest_layer(layer_state | default_layer_state);
+
+    return override->trigger == keycode && keycode != KC_NO && (override->enabled == NULL || *override->enabled) && (held & triggered) == triggered && !(mods & override->negative_mod_mask) && (override->layers & ((layer_state_t)1 << layer));
+}
+
+static void deactivate_override(void) {
+    if (host_active_override == NULL) {
+        return;
+    }
+    if (host_active_override->replacement <= QK_MODS_MAX) {
+        unregister_code(QK_MODS_GET_BASIC_KEYCODE(host_active_override->replacement));
+    }
+    weak_override_mods = 0;
+    clear_suppressed_override_mods();
+    send_keyboard_report();
+    host_active_override = NULL;
+}
+
+bool process_key_override(const uint16_t keycode, const keyrecord_t *const record) {
+    if (!record->event.pressed) {
+        if (host_active_override != NULL && KEYEQ(record->event.key, active_trigger)) {
+            deactivate_override();
+            return false;
+        }
+        return true;
+    }
+
+    deactivate_override();
+    uint16_t trigger = keycode;
+    if (host_hooks.match_mod_taps && IS_QK_MOD_TAP(keycode) && record->tap.count > 0) {
+        trigger = QK_MOD_TAP_GET_TAP_KEYCODE(keycode);
+    }
+
+    uint8_t  mods  = get_mods() | get_oneshot_mods();
+    uint16_t count = host_hooks.override_count();
+    for (uint16_t i = 0; i < count; i++) {
+        const key_override_t *override = host_hooks.override_get(i);
+        if (override == NULL || !override_matches(override, trigger, mods)) {
+            continue;
+        }
+
+        host_active_override = override;
+        host_override_activations++;
+        active_trigger = record->event.key;
+        if (host_hooks.remember_overrides && !repeating && remembered_by_repeat(override->replacement, record)) {
+            // One-shot mods only go out with a basic replacement
+            bool    modded    = override->replacement <= QK_MODS_MAX;
+            uint8_t kept_mods = (get_mods() | get_weak_mods() | (modded ? get_oneshot_mods() : 0)) & ~override->suppressed_mods;
+            set_last_keycode(modded ? QK_MODS_GET_BASIC_KEYCODE(override->replacement) : override->replacement);
+            set_last_mods((modded ? mod_config(QK_MODS_GET_MODS(override->replacement)) : 0) | kept_mods);
+        }
+        set_suppressed_override_mods(override->suppressed_mods);
+        del_oneshot_mods(override->suppressed_mods);
+        if (override->replacement <= QK_MODS_MAX) {
+            weak_override_mods = mod_config(QK_MODS_GET_MODS(override->replacement));
+            register_code(QK_MODS_GET_BASIC_KEYCODE(override->replacement));
+        } else {
+            // Quantum and user keycodes are tapped through the keymap
+            keyrecord_t replacement = *record;
+            host_hooks.process_record(override->replacement, &replacement);
+            replacement.event.pressed = false;
+            host_hooks.process_record(override->replacement, &replacement);
+        }
+        return false;
+    }
+    return true;
+}
+
+// Basic actions
+
+typedef struct {
+    uint16_t keycode; // keycode the press resolved to, used for the release
+    uint8_t  tapped;  // tap count the press was settled with
+    bool     interrupted;
+} position_t;
+
+static position_t positions[MATRIX_ROWS][MATRIX_COLS];
+
+static bool remembered_by_repeat(uint16_t keycode, const keyrecord_t *record) {
+    switch (keycode) {
+        case KC_NO:
+        case KC_TRNS:
+        case QK_REPEAT_KEY:
+        case QK_ALT_REPEAT_KEY:
+            return false;
+    }
+    if (IS_QK_TO(keycode) || IS_QK_ONE_SHOT_MOD(keycode) || IS_MODIFIER_KEYCODE(keycode)) {
+        return false;
+    }
+    return !IS_QK_MOD_TAP(keycode) || record->tap.count > 0;
+}
+
+static void process_keycode(uint16_t keycode, keyrecord_t *record, position_t *position);
+
+// QMK's repeat_key_invoke(): the remembered keycode goes through the whole
+// pipeline again, with the remembered mods added as weak mods while it is held
+static void repeat_key_invoke(keyrecord_t *record) {
+    if (repeating) {
+        return;
+    }
+    if (record->event.pressed) {
+        repeated_keycode = last_keycode;
+        if (repeat_count < INT8_MAX) {
+            repeat_count++;
+        }
+        add_weak_mods(last_mods);
+    }
+    keyrecord_t repeated = *record;
+    repeating            = true;
+    process_keycode(repeated_keycode, &repeated, NULL);
+    repeating = false;
+    if (!record->event.pressed) {
+        del_weak_mods(last_mods);
+        send_keyboard_report();
+        repeated_keycode = KC_NO;
+    }
+}
+
+// position is NULL for combos and the repeat key
+static void process_action(uint16_t keycode, keyrecord_t *record, position_t *position) {
+    bool pressed = record->event.pressed;
+
+    if (IS_QK_MOD_TAP(keycode) && record->tap.count > 0) {
+        if (pressed) {
+            register_code(QK_MOD_TAP_GET_TAP_KEYCODE(keycode));
+        } else {
+            unregister_code(QK_MOD_TAP_GET_TAP_KEYCODE(keycode));
+        }
+    } else if (IS_QK_MOD_TAP(keycode) || IS_QK_ONE_SHOT_MOD(keycode)) {
+        // A one-shot key held while another key is pressed is an ordinary
+        // mod; tapped on its own, its mod applies to the next key
+        uint8_t mods = mod_config(IS_QK_MOD_TAP(keycode) ? QK_MOD_TAP_GET_MODS(keycode) : QK_ONE_SHOT_MOD_GET_MODS(keycode));
+        if (pressed) {
+            add_mods(mods);
+        } else {
+            del_mods(mods);
+            if (IS_QK_ONE_SHOT_MOD(keycode) && position != NULL && !position->interrupted) {
+                add_oneshot_mods(mods);
+            }
+        }
+        send_keyboard_report();
+    } else if (IS_QK_TO(keycode)) {
+        if (pressed) {
+            layer_move(QK_TO_GET_LAYER(keycode));
+        }
+    } else if (keycode == QK_REPEAT_KEY) {
+        repeat_key_invoke(record);
+    } else if (keycode > KC_TRNS && keycode <= QK_MODS_MAX) {
+        if (pressed) {
+            register_code16(keycode);
+        } else {
+            unregister_code16(keycode);
+        }
+    }
+}
+
+// Everything after tap-hold: repeat memory, the keymap, the key override
+// engine and the basic action, in QMK's order
+static void process_keycode(uint16_t keycode, keyrecord_t *record, position_t *position) {
+    if (record->event.pressed && !repeating && remembered_by_repeat(keycode, record)) {
+        uint8_t mods = get_mods() | get_weak_mods() | get_oneshot_mods();
+        if (remember_last_key_user(keycode, record, &mods)) {
+            set_last_keycode(IS_QK_MOD_TAP(keycode) ? QK_MOD_TAP_GET_TAP_KEYCODE(keycode) : keycode);
+            set_last_mods(mods);
+            repeat_count = 0;
+        }
+    }
+
+    // Releasing the repeat key releases the key it repeated, and that release
+    // is the one that deactivates the override the repeated key activated
+    bool repeat_release = keycode == QK_REPEAT_KEY && !record->event.pressed && repeated_keycode != KC_NO;
+
+    if (host_hooks.process_record(keycode, record) && (repeat_release || process_key_override(keycode, record))) {
+        process_action(keycode, record, position);
+    }
+}
+
+static void process_record(keypos_t key, bool pressed, uint16_t time, uint8_t tap_count) {
+    position_t *position = &positions[key.row][key.col];
+    if (pressed) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                positions[row][col].interrupted = true;
+            }
+        }
+        position->keycode     = keycode_for(key);
+        position->tapped      = tap_count;
+        position->interrupted = false;
+    }
+
+    keyrecord_t record = {.event = {.key = key, .pressed = pressed, .time = time}, .tap = {.count = position->tapped}};
+    if (pressed) {
+        host_key_presses++;
+    }
+    process_keycode(position->keycode, &record, position);
+    if (!pressed) {
+        position->keycode = KC_NO;
+    }
+}
+
+// Tap-hold
+// A model of QMK's action_tapping.c for this keymap's config.h: a mod-tap
+// pressed within get_flow_tap_term() of the previous key is tapped straight
+// away (Flow Tap). Otherwise later events wait until it is settled: released
+// first, it is a tap. A key on the same hand pressed meanwhile makes it a tap
+// (Chordal Hold), and a key on the other hand pressed and released within it
+// makes it a hold (PERMISSIVE_HOLD), as does holding it for TAPPING_TERM.
+
+typedef struct {
+    keypos_t key;
+    bool     pressed;
+    uint16_t time;
+} tap_event_t;
+
+static struct {
+    bool        active;
+    tap_event_t press;
+    uint16_t    keycode;
+} pending;
+
+static tap_event_t waiting[32];
+static uint8_t     waiting_count;
+static uint16_t    prev_keycode;
+static uint16_t    prev_time;
+
+static void tapping_event(tap_event_t event);
+
+static void settle(bool tap) {
+    pending.active = false;
+    prev_keycode   = pending.keycode;
+    prev_time      = pending.press.time;
+    process_record(pending.press.key, true, pending.press.time, tap ? 1 : 0);
+
+    tap_event_t events[ARRAY_SIZE(waiting)];
+    uint8_t     count = waiting_count;
+    memcpy(events, waiting, sizeof(tap_event_t) * count);
+    waiting_count = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        tapping_event(events[i]);
+    }
+}
+
+static void tapping_event(tap_event_t event) {
+    if (pending.active && TIMER_DIFF_16(event.time, pending.press.time) >= TAPPING_TERM) {
+        settle(false);
+    }
+
+    if (!pending.active) {
+        if (!event.pressed) {
+            process_record(event.key, false, event.time, 0);
+            return;
+        }
+
+        uint16_t    keycode = keycode_for(event.key);
+        keyrecord_t record  = {.event = {.key = event.key, .pressed = true, .time = event.time}};
+        if (IS_QK_MOD_TAP(keycode)) {
+            uint16_t flow_tap_term = get_flow_tap_term(keycode, &record, prev_keycode);
+            if (flow_tap_term == 0 || TIMER_DIFF_16(event.time, prev_time) >= flow_tap_term) {
+                pending.active  = true;
+                pending.press   = event;
+                pending.keycode = keycode;
+                return;
+            }
+        }
+        prev_keycode = keycode;
+        prev_time    = event.time;
+        process_record(event.key, true, event.time, IS_QK_MOD_TAP(keycode) ? 1 : 0);
+        return;
+    }
+
+    if (!event.pressed && KEYEQ(event.key, pending.press.key)) {
+        settle(true);
+        process_record(event.key, false, event.time, 1);
+        return;
+    }
+
+    if (event.pressed && chordal_hold_handedness(event.key) == chordal_hold_handedness(pending.press.key)) {
+        settle(true);
+        tapping_event(event);
+        return;
+    }
+
+    if (!event.pressed) {
+        for (uint8_t i = 0; i < waiting_count; i++) {
+            if (waiting[i].pressed && KEYEQ(waiting[i].key, event.key)) {
+                waiting[waiting_count++] = event;
+                settle(false);
+                return;
+            }
+        }
+    }
+
+    if (waiting_count < ARRAY_SIZE(waiting) - 1) {
+        waiting[waiting_count++] = event;
+    }
+}
+
+// Combos
+// A model of QMK's process_combo.c, which runs before tap-hold: a press of a
+// combo key that combo_should_trigger() lets through is held back, as are
+// presses of the other keys of the combos it could still start. Once every
+// key of one of them is down, the combo's keycode is pressed in their place
+// (and released with the first of them). Any other event, or a combo's
+// get_combo_term() running out, lets the held back presses through.
+
+#define COMBO_KEYS_MAX 4
+
+static struct {
+    tap_event_t events[COMBO_KEYS_MAX];
+    uint8_t     count;
+    uint32_t    candidates; // bit per key_combos[] index
+} combo_buffer;
+
+static struct {
+    bool     active;
+    uint16_t keycode;
+    keypos_t keys[COMBO_KEYS_MAX];
+    uint8_t  count;
+} combo_held;
+
+static bool combo_has_key(const combo_t *combo, uint16_t keycode, uint8_t *index) {
+    for (uint8_t i = 0; i < COMBO_KEYS_MAX && combo->keys[i] != COMBO_END; i++) {
+        if (combo->keys[i] == keycode) {
+            *index = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool combo_complete(const combo_t *combo) {
+    for (uint8_t i = 0; i < COMBO_KEYS_MAX && combo->keys[i] != COMBO_END; i++) {
+        if (!(combo->state & (1 << i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void combo_clear(void) {
+    for (uint16_t i = 0; i < host_combo_count; i++) {
+        key_combos[i].state = 0;
+    }
+    combo_buffer.count      = 0;
+    combo_buffer.candidates = 0;
+}
+
+static void combo_flush(void) {
+    tap_event_t events[COMBO_KEYS_MAX];
+    uint8_t     count = combo_buffer.count;
+    memcpy(events, combo_buffer.events, sizeof(tap_event_t) * count);
+    combo_clear();
+    for (uint8_t i = 0; i < count; i++) {
+        tapping_event(events[i]);
+    }
+}
+
+static void combo_fire(uint16_t index) {
+    combo_held.active  = true;
+    combo_held.keycode = key_combos[index].keycode;
+    combo_held.count   = combo_buffer.count;
+    for (uint8_t i = 0; i < combo_buffer.count; i++) {
+        combo_held.keys[i] = combo_buffer.events[i].key;
+    }
+
+    keyrecord_t record = {.event = {.key = {.row = 254, .col = 254}, .pressed = true, .time = now}};
+    combo_clear();
+    host_key_presses++;
+    process_keycode(combo_held.keycode, &record, NULL);
+}
+
+static uint16_t combo_term(void) {
+    uint16_t term = 0;
+    for (uint16_t i = 0; i < host_combo_count; i++) {
+        if (combo_buffer.candidates & (1UL << i)) {
+            uint16_t combo = get_combo_term(i, &key_combos[i]);
+            term           = combo > term ? combo : term;
+        }
+    }
+    return term;
+}
+
+static void combo_event(tap_event_t event) {
+    if (!event.pressed) {
+        for (uint8_t i = 0; i < combo_held.count; i++) {
+            if (KEYEQ(combo_held.keys[i], event.key)) {
+                combo_held.keys[i] = combo_held.keys[--combo_held.count];
+                if (combo_held.active) {
+                    keyrecord_t record = {.event = {.key = {.row = 254, .col = 254}, .pressed = false, .time = event.time}};
+                    combo_held.active  = false;
+                    process_keycode(combo_held.keycode, &record, NULL);
+                }
+                return;
+            }
+        }
+        combo_flush();
+        tapping_event(event);
+        return;
+    }
+
+    uint16_t    keycode    = keycode_for(event.key);
+    keyrecord_t record     = {.event = {.key = event.key, .pressed = true, .time = event.time}};
+    uint32_t    candidates = 0;
+    for (uint16_t i = 0; i < host_combo_count; i++) {
+        uint8_t key;
+        if (combo_buffer.count > 0 && !(combo_buffer.candidates & (1UL << i))) {
+            continue;
+        }
+        if (key_combos[i].disabled || !combo_has_key(&key_combos[i], keycode, &key) || !combo_should_trigger(i, &key_combos[i], keycode, &record)) {
+            continue;
+        }
+        candidates |= 1UL << i;
+    }
+
+    if (candidates == 0 || combo_buffer.count == COMBO_KEYS_MAX) {
+        combo_flush();
+        tapping_event(event);
+        return;
+    }
+
+    combo_buffer.events[combo_buffer.count++] = event;
+    combo_buffer.candidates                   = candidates;
+    for (uint16_t i = 0; i < host_combo_count; i++) {
+        uint8_t key;
+        if ((candidates & (1UL << i)) && combo_has_key(&key_combos[i], keycode, &key)) {
+            key_combos[i].state |= 1 << key;
+            if (combo_complete(&key_combos[i])) {
+                combo_fire(i);
+                return;
+            }
+        }
+    }
+}
+
+// Runtime
+
+static bool held_keys[MATRIX_ROWS][MATRIX_COLS];
+
+uint32_t host_time(void) {
+    return now;
+}
+
+void host_advance(uint32_t ms) {
+    for (uint32_t i = 0; i < ms; i++) {
+        now++;
+        if (combo_buffer.count > 0 && TIMER_DIFF_16(now, combo_buffer.events[0].time) >= combo_term()) {
+            combo_flush();
+        }
+        if (pending.active && TIMER_DIFF_16(now, pending.press.time) >= TAPPING_TERM) {
+            settle(false);
+        }
+        housekeeping_task_user();
+    }
+}
+
+void host_key_event(uint8_t row, uint8_t col, bool pressed) {
+    keypos_t    key    = {.row = row, .col = col};
+    keyrecord_t record = {.event = {.key = key, .pressed = pressed, .time = now}};
+    if (held_keys[row][col] == pressed) {
+        return; // No edge
+    }
+    held_keys[row][col] = pressed;
+    if (!pre_process_record_user(keycode_for(key), &record)) {
+        return;
+    }
+    combo_event((tap_event_t){.key = key, .pressed = pressed, .time = now});
+}
+
+void host_release_all(void) {
+    host_advance(TAPPING_TERM);
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            host_key_event(row, col, false);
+        }
+    }
+    host_advance(TAPPING_TERM);
+}
+
+void host_reset(void) {
+    now                 = 0;
+    real_mods           = 0;
+    weak_mods           = 0;
+    oneshot_mods        = 0;
+    suppressed_mods     = 0;
+    weak_override_mods  = 0;
+    last_keycode        = KC_NO;
+    last_mods           = 0;
+    repeating           = false;
+    repeated_keycode    = KC_NO;
+    repeat_count        = 0;
+    layer_state         = 0;
+    default_layer_state = 1;
+    memset(report_keys, 0, sizeof(report_keys));
+    memset(positions, 0, sizeof(positions));
+    memset(held_keys, 0, sizeof(held_keys));
+    combo_clear();
+    combo_held.active = false;
+    combo_held.count  = 0;
+    pending.active            = false;
+    waiting_count             = 0;
+    prev_keycode              = KC_NO;
+    prev_time                 = 0;
+    host_report_count         = 0;
+    host_report_total         = 0;
+    host_active_override      = NULL;
+    host_override_activations = 0;
+    host_key_presses          = 0;
+    host_hooks                = (host_hooks_t){.process_record = process_record_user, .override_count = key_override_count, .override_get = key_override_get};
+    keyboard_post_init_user();
+}
+
+// Traces
+
+int host_read_trace(const char *path, host_event_t *events, int max) {
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        return -1;
+    }
+    int          count = 0;
+    char         line[128];
+    unsigned int time, row, col;
+    char         edge;
+    while (fgets(line, sizeof(line), file)) {
+        if (line[0] == '#' || sscanf(line, "%u %u %u %c", &time, &row, &col, &edge) != 4) {
+            continue;
+        }
+        if (count < max && row < MATRIX_ROWS && col < MATRIX_COLS) {
+            events[count++] = (host_event_t){.time = time, .row = row, .col = col, .pressed = edge == 'd'};
+        }
+    }
+    fclose(file);
+    return count;
+}
+
+void host_write_trace(FILE *file, const host_event_t *events, int count) {
+    for (int i = 0; i < count; i++) {
+        fprintf(file, "%u %u %u %c\n", events[i].time, events[i].row, events[i].col, events[i].pressed ? 'd' : 'u');
+    }
+}
+
+void host_replay(const host_event_t *events, int count) {
+    host_reset();
+    for (int i = 0; i < count; i++) {
+        if (events[i].time > now) {
+            host_advance(events[i].time - now);
+        }
+        host_key_event(events[i].row, events[i].col, events[i].pressed);
+    }
+    host_release_all();
+}
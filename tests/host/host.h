@@ -0,0 +1,85 @@
+// Host runtime for keymap.c: the parts of QMK's core the keymap runs inside,
+// modelled closely enough to drive it with matrix events and read back the
+// HID reports it sends (see readme.md for what is and isn't modelled).
+#pragma once
+
+#include <stdio.h>
+
+#include "quantum.h"
+
+// One keyboard report, as sent to the host
+typedef struct {
+    uint32_t time;
+    uint8_t  mods;
+    uint8_t  keys[6];
+} host_report_t;
+
+// Reports sent since host_reset(). Older reports are dropped once
+// HOST_REPORT_LOG is full, but host_report_total keeps counting.
+#define HOST_REPORT_LOG 16384
+extern host_report_t host_reports[HOST_REPORT_LOG];
+extern uint32_t      host_report_count;
+extern uint32_t      host_report_total;
+
+// Hooks the pipeline calls, so the fuzzer can swap in a reference
+// configuration. host_reset() points them at keymap.c.
+typedef struct {
+    bool (*process_record)(uint16_t keycode, keyrecord_t *record);
+    uint16_t (*override_count)(void);
+    const key_override_t *(*override_get)(uint16_t index);
+    // The stock engine only matches plain keycodes; the reference
+    // configuration also matches tapped mod-taps by their tap keycode
+    bool match_mod_taps;
+    // ... and has the repeat key remember what an override typed, as
+    // process_symbols() does, instead of the trigger and its mods
+    bool remember_overrides;
+} host_hooks_t;
+extern host_hooks_t host_hooks;
+
+// Override the key override engine activated most recently, or NULL, and how
+// many it has activated since host_reset()
+extern const key_override_t *host_active_override;
+extern uint32_t              host_override_activations;
+
+// Key presses that have come out of combos and tap-hold into the keymap since
+// host_reset(), counting a combo as one. The repeat key replaying a keycode
+// and overrides tapping their replacement don't count.
+extern uint32_t host_key_presses;
+
+// Start over: no keys or mods held, BASE layer, time 0, empty report log
+void host_reset(void);
+
+// Current time in ms, and moving it on (running the tap-hold timeout and
+// housekeeping on the way)
+uint32_t host_time(void);
+void     host_advance(uint32_t ms);
+
+// A matrix event at the current time, through the tap-hold model, the
+// keymap's hooks, the key override engine and the basic actions
+void host_key_event(uint8_t row, uint8_t col, bool pressed);
+
+// Release every held key and let every timeout expire
+void host_release_all(void);
+
+// Key presses in the report log, as (mods, key) pairs in the order they were
+// sent, with the time of the report. Returns how many were written to
+// presses (up to max).
+typedef struct {
+    uint32_t time;
+    uint8_t  mods;
+    uint8_t  key;
+} host_press_t;
+uint32_t host_presses(host_press_t *presses, uint32_t max);
+
+// Trace files: one event per line, "<time ms> <row> <col> <d|u>"
+typedef struct {
+    uint32_t time;
+    uint8_t  row;
+    uint8_t  col;
+    bool     pressed;
+} host_event_t;
+int  host_read_trace(const char *path, host_event_t *events, int max);
+void host_write_trace(FILE *file, const host_event_t *events, int count);
+
+// Replay events from host_reset(), ending with host_release_all()
+void host_replay(const host_event_t *events, int count);
@@ -0,0 +1,10 @@
+// keymap.c itself, built for the host. Each test program includes this once,
+// so it can reach the keymap's static tables and state as well as its hooks.
+#pragma once
+
+#include "host.h"
+
+#include "keymap.c"
+
+const uint8_t host_keymap_layer_count = ARRAY_SIZE(keymaps);
+const uint16_t host_combo_count = ARRAY_SIZE(key_combos);
@@ -0,0 +1,258 @@
+// Trace replay benchmark for keymap.c
+//
+//   keysim [-r|-t|-l] [-n runs] <trace>  replay a trace, report events/second
+//                                        and per-event latency percentiles
+//   keysim -w <wpm> <text>               write a trace typing the text
+//
+// -r prints the keyboard reports the first replay sends, -t the text they
+// type, and -l how long after each key press its key was reported. Traces
+// have one event per line, "<time ms> <row> <col> <d|u>" (see host.h).
+#include <stdlib.h>
+#include <time.h>
+
+#include "keymap_host.h"
+
+#define TRACE_MAX 65536
+
+static host_event_t events[TRACE_MAX];
+
+static uint64_t nanoseconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+static int compare_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+static void print_reports(void) {
+    for (uint32_t i = 0; i < host_report_count; i++) {
+        const host_report_t *report = &host_reports[i];
+        printf("%6u mods %02X keys", report->time, report->mods);
+        for (uint8_t k = 0; k < 6; k++) {
+            printf(" %02X", report->keys[k]);
+        }
+        printf("\n");
+    }
+}
+
+// Letters, space, '.' and ',' as typed on a US or UK layout, '?' for anything else
+static void print_text(void) {
+    static host_press_t presses[HOST_REPORT_LOG];
+    uint32_t            count = host_presses(presses, ARRAY_SIZE(presses));
+    for (uint32_t i = 0; i < count; i++) {
+        bool shifted = presses[i].mods & MOD_MASK_SHIFT;
+        if (presses[i].key >= KC_A && presses[i].key <= KC_Z && !(presses[i].mods & ~MOD_MASK_SHIFT)) {
+            putchar((shifted ? 'A' : 'a') + presses[i].key - KC_A);
+        } else if (presses[i].key == KC_SPACE && !presses[i].mods) {
+            putchar(' ');
+        } else if (presses[i].key == KC_DOT && !presses[i].mods) {
+            putchar('.');
+        } else if (presses[i].key == KC_COMMA && !presses[i].mods) {
+            putchar(',');
+        } else {
+            putchar('?');
+        }
+    }
+    putchar('\n');
+}
+
+static void print_percentiles(const char *name, uint64_t *samples, int count) {
+    if (count == 0) {
+        printf("%s: none\n", name);
+        return;
+    }
+    uint64_t total = 0;
+    for (int i = 0; i < count; i++) {
+        total += samples[i];
+    }
+    qsort(samples, count, sizeof(uint64_t), compare_u64);
+    printf("%s (%d presses): mean %.1f  p50 %llu  p90 %llu  p99 %llu  max %llu\n", name, count, (double)total / count, (unsigned long long)samples[count / 2], (unsigned long long)samples[count * 9 / 10], (unsigned long long)samples[count * 99 / 100], (unsigned long long)samples[count - 1]);
+}
+
+// Press to report in simulated ms, for presses of BASE keys that type a basic
+// keycode (mod-taps their tap keycode). Presses are matched in order to the
+// keys in the report log, up to the key's release: a key the keymap turns into
+// something else, such as a symbol, isn't counted.
+static void print_press_latency(int count) {
+    static host_press_t presses[HOST_REPORT_LOG];
+    uint32_t            sent          = host_presses(presses, ARRAY_SIZE(presses));
+    uint64_t           *keys          = malloc(sizeof(uint64_t) * count);
+    uint64_t           *mod_taps      = malloc(sizeof(uint64_t) * count);
+    int                 key_count     = 0;
+    int                 mod_tap_count = 0;
+    uint32_t            next          = 0;
+    for (int i = 0; i < count; i++) {
+        uint16_t keycode = keycode_at_keymap_location(BASE, events[i].row, events[i].col);
+        bool     mod_tap = IS_QK_MOD_TAP(keycode);
+        if (mod_tap) {
+            keycode = QK_MOD_TAP_GET_TAP_KEYCODE(keycode);
+        }
+        if (!events[i].pressed || !IS_BASIC_KEYCODE(keycode)) {
+            continue;
+        }
+        int release = i + 1;
+        while (release < count && (events[release].pressed || events[release].row != events[i].row || events[release].col != events[i].col)) {
+            release++;
+        }
+        uint32_t until = release < count ? events[release].time : UINT32_MAX;
+        uint32_t n     = next;
+        while (n < sent && presses[n].time <= until && presses[n].key != keycode) {
+            n++;
+        }
+        if (n == sent || presses[n].time > until) {
+            continue;
+        }
+        keys[key_count++] = presses[n].time - events[i].time;
+        if (mod_tap) {
+            mod_taps[mod_tap_count++] = presses[n].time - events[i].time;
+        }
+        next = n + 1;
+    }
+    print_percentiles("press to report ms, all keys", keys, key_count);
+    print_percentiles("press to report ms, mod-taps", mod_taps, mod_tap_count);
+    free(keys);
+    free(mod_taps);
+}
+
+static int replay(const char *path, int runs, bool reports, bool text, bool press_latency) {
+    int count = host_read_trace(path, events, TRACE_MAX);
+    if (count <= 0) {
+        fprintf(stderr, "keysim: can't read events from %s\n", path);
+        return 1;
+    }
+
+    uint64_t *latency = malloc(sizeof(uint64_t) * count * runs);
+    uint64_t  total   = 0;
+    for (int run = 0; run < runs; run++) {
+        host_reset();
+        for (int i = 0; i < count; i++) {
+            if (events[i].time > host_time()) {
+                host_advance(events[i].time - host_time());
+            }
+            uint64_t start = nanoseconds();
+            host_key_event(events[i].row, events[i].col, events[i].pressed);
+            uint64_t elapsed = nanoseconds() - start;
+
+            latency[run * count + i] = elapsed;
+            total += elapsed;
+        }
+        host_release_all();
+        if (reports && run == 0) {
+            print_reports();
+        }
+        if (text || press_latency) {
+            if (text) {
+                print_text();
+            } else {
+                print_press_latency(count);
+            }
+            free(latency);
+            return 0;
+        }
+    }
+
+    int samples = count * runs;
+    qsort(latency, samples, sizeof(uint64_t), compare_u64);
+    printf("%d events x %d runs, %u reports per run\n", count, runs, host_report_total);
+    printf("%.0f events/s\n", samples / (total / 1e9));
+    printf("latency ns: p50 %llu  p90 %llu  p99 %llu  max %llu\n", (unsigned long long)latency[samples / 2], (unsigned long long)latency[samples * 9 / 10], (unsigned long long)latency[samples * 99 / 100], (unsigned long long)latency[samples - 1]);
+    free(latency);
+    return 0;
+}
+
+// Typing a text on the BASE layer: letters, space, '.' and ','; capitals and
+// ',' (Shift+.) with the one-shot Shift key. Everything else is skipped.
+static uint32_t seed = 1;
+
+static uint32_t jitter(uint32_t ms) {
+    seed = seed * 1103515245 + 12345;
+    return ms * 7 / 10 + (seed >> 16) % (ms * 6 / 10 + 1);
+}
+
+static bool find_key(uint16_t keycode, host_event_t *event) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            uint16_t key = keycode_at_keymap_location(BASE, row, col);
+            if (key == keycode || (IS_QK_MOD_TAP(key) && QK_MOD_TAP_GET_TAP_KEYCODE(key) == keycode)) {
+                event->row = row;
+                event->col = col;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+static uint32_t type_key(uint16_t keycode, uint32_t time, uint32_t interval) {
+    host_event_t event;
+    if (!find_key(keycode, &event)) {
+        return time;
+    }
+    event.time    = time;
+    event.pressed = true;
+    host_write_trace(stdout, &event, 1);
+    event.time    = time + jitter(interval < 60 ? interval : 60);
+    event.pressed = false;
+    host_write_trace(stdout, &event, 1);
+    return time + jitter(interval);
+}
+
+static int write_text_trace(int wpm, const char *path) {
+    FILE *file = fopen(path, "r");
+    if (file == NULL || wpm <= 0) {
+        fprintf(stderr, "keysim: can't read %s\n", path);
+        return 1;
+    }
+    uint32_t interval = 60000 / (wpm * 5);
+    uint32_t time     = 0;
+    int      c;
+    while ((c = fgetc(file)) != EOF) {
+        if (c >= 'A' && c <= 'Z') {
+            time = type_key(OSM(MOD_LSFT), time, interval);
+            c += 'a' - 'A';
+        } else if (c == ',') {
+            time = type_key(OSM(MOD_LSFT), time, interval);
+            c = '.';
+        }
+        if (c >= 'a' && c <= 'z') {
+            time = type_key(KC_A + c - 'a', time, interval);
+        } else if (c == '.') {
+            time = type_key(KC_DOT, time, interval);
+        } else if (c == ' ' || c == '\n') {
+            time = type_key(KC_SPACE, time, interval);
+        }
+    }
+    fclose(file);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    int  runs    = 1;
+    bool reports = false;
+    bool text    = false;
+    bool latency = false;
+    int  arg     = 1;
+    for (; arg < argc && argv[arg][0] == '-'; arg++) {
+        if (strcmp(argv[arg], "-r") == 0) {
+            reports = true;
+        } else if (strcmp(argv[arg], "-t") == 0) {
+            text = true;
+        } else if (strcmp(argv[arg], "-l") == 0) {
+            latency = true;
+        } else if (strcmp(argv[arg], "-n") == 0 && arg + 1 < argc) {
+            runs = atoi(argv[++arg]);
+        } else if (strcmp(argv[arg], "-w") == 0 && arg + 2 < argc) {
+            return write_text_trace(atoi(argv[arg + 1]), argv[arg + 2]);
+        } else {
+            break;
+        }
+    }
+    if (arg != argc - 1 || runs < 1) {
+        fprintf(stderr, "usage: keysim [-r|-t|-l] [-n runs] <trace>\n       keysim -w <wpm> <text>\n");
+        return 2;
+    }
+    return replay(argv[arg], runs, reports, text, latency);
+}
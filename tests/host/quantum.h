@@ -0,0 +1,392 @@
+// Stand-in for QMK's quantum.h, so keymap.c builds on the host (see
+// readme.md). Only what keymap.c and its generated tables use is declared.
+// Keycode values, mod bits and struct layouts match QMK, so tables generated
+// for the firmware compile unchanged; behaviour lives in host.c.
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Flash is ordinary memory on the host
+#define PROGMEM
+#define pgm_read_byte(p) (*(const uint8_t *)(p))
+#define pgm_read_word(p) (*(const uint16_t *)(p))
+#define pgm_read_dword(p) (*(const uint32_t *)(p))
+#define memcpy_P memcpy
+
+#define ARRAY_SIZE(array) (sizeof(array) / sizeof((array)[0]))
+
+// Ferris Sweep matrix: each half is 4 rows of 5 columns
+#define MATRIX_ROWS 8
+#define MATRIX_COLS 5
+
+// clang-format off
+#define LAYOUT_split_3x5_2( \
+    k0A, k0B, k0C, k0D, k0E, k4A, k4B, k4C, k4D, k4E, \
+    k1A, k1B, k1C, k1D, k1E, k5A, k5B, k5C, k5D, k5E, \
+    k2A, k2B, k2C, k2D, k2E, k6A, k6B, k6C, k6D, k6E, \
+                   k3D, k3E, k7A, k7B) \
+    { \
+        {k0A, k0B, k0C, k0D, k0E}, \
+        {k1A, k1B, k1C, k1D, k1E}, \
+        {k2A, k2B, k2C, k2D, k2E}, \
+        {KC_NO, KC_NO, KC_NO, k3D, k3E}, \
+        {k4E, k4D, k4C, k4B, k4A}, \
+        {k5E, k5D, k5C, k5B, k5A}, \
+        {k6E, k6D, k6C, k6B, k6A}, \
+        {KC_NO, KC_NO, KC_NO, k7B, k7A} \
+    }
+// clang-format on
+
+typedef uint32_t layer_state_t;
+
+typedef struct {
+    uint8_t col;
+    uint8_t row;
+} keypos_t;
+
+#define KEYEQ(keya, keyb) ((keya).row == (keyb).row && (keya).col == (keyb).col)
+
+typedef struct {
+    keypos_t key;
+    bool     pressed;
+    uint8_t  type;
+    uint16_t time;
+} keyevent_t;
+
+typedef struct {
+    bool    interrupted : 1;
+    bool    reserved2 : 1;
+    bool    reserved1 : 1;
+    bool    reserved0 : 1;
+    uint8_t count : 4;
+} tap_t;
+
+typedef struct {
+    keyevent_t event;
+    tap_t      tap;
+    uint16_t   keycode;
+} keyrecord_t;
+
+// Basic keycodes (HID usages)
+// clang-format off
+enum basic_keycodes {
+    KC_NO = 0x00, KC_TRANSPARENT = 0x01,
+    KC_A = 0x04, KC_B, KC_C, KC_D, KC_E, KC_F, KC_G, KC_H, KC_I, KC_J, KC_K, KC_L, KC_M,
+    KC_N, KC_O, KC_P, KC_Q, KC_R, KC_S, KC_T, KC_U, KC_V, KC_W, KC_X, KC_Y, KC_Z,
+    KC_1, KC_2, KC_3, KC_4, KC_5, KC_6, KC_7, KC_8, KC_9, KC_0,
+    KC_ENTER, KC_ESCAPE, KC_BACKSPACE, KC_TAB, KC_SPACE, KC_MINUS, KC_EQUAL,
+    KC_LEFT_BRACKET, KC_RIGHT_BRACKET, KC_BACKSLASH, KC_NONUS_HASH, KC_SEMICOLON,
+    KC_QUOTE, KC_GRAVE, KC_COMMA, KC_DOT, KC_SLASH, KC_CAPS_LOCK,
+    KC_F1, KC_F2, KC_F3, KC_F4, KC_F5, KC_F6, KC_F7, KC_F8, KC_F9, KC_F10, KC_F11, KC_F12,
+    KC_PRINT_SCREEN, KC_SCROLL_LOCK, KC_PAUSE, KC_INSERT, KC_HOME, KC_PAGE_UP,
+    KC_DELETE, KC_END, KC_PAGE_DOWN, KC_RIGHT, KC_LEFT, KC_DOWN, KC_UP,
+    KC_NUM_LOCK, KC_KP_SLASH, KC_KP_ASTERISK, KC_KP_MINUS, KC_KP_PLUS, KC_KP_ENTER,
+    KC_KP_1, KC_KP_2, KC_KP_3, KC_KP_4, KC_KP_5, KC_KP_6, KC_KP_7, KC_KP_8, KC_KP_9,
+    KC_KP_0, KC_KP_DOT, KC_NONUS_BACKSLASH,
+    KC_EXSEL = 0xA4,
+    MS_UP = 0xCD, MS_DOWN, MS_LEFT, MS_RGHT, MS_BTN1, MS_BTN2, MS_BTN3, MS_BTN4,
+    MS_BTN5, MS_BTN6, MS_BTN7, MS_BTN8, MS_WHLU, MS_WHLD, MS_WHLL, MS_WHLR,
+    MS_ACL0, MS_ACL1, MS_ACL2,
+    KC_LEFT_CTRL = 0xE0, KC_LEFT_SHIFT, KC_LEFT_ALT, KC_LEFT_GUI,
+    KC_RIGHT_CTRL, KC_RIGHT_SHIFT, KC_RIGHT_ALT, KC_RIGHT_GUI
+};
+// clang-format on
+
+#define KC_TRNS KC_TRANSPARENT
+#define KC_ENT KC_ENTER
+#define KC_ESC KC_ESCAPE
+#define KC_BSPC KC_BACKSPACE
+#define KC_SPC KC_SPACE
+#define KC_MINS KC_MINUS
+#define KC_EQL KC_EQUAL
+#define KC_LBRC KC_LEFT_BRACKET
+#define KC_RBRC KC_RIGHT_BRACKET
+#define KC_BSLS KC_BACKSLASH
+#define KC_NUHS KC_NONUS_HASH
+#define KC_SCLN KC_SEMICOLON
+#define KC_QUOT KC_QUOTE
+#define KC_GRV KC_GRAVE
+#define KC_COMM KC_COMMA
+#define KC_SLSH KC_SLASH
+#define KC_NUBS KC_NONUS_BACKSLASH
+#define KC_DEL KC_DELETE
+#define KC_PGUP KC_PAGE_UP
+#define KC_PGDN KC_PAGE_DOWN
+#define KC_RGHT KC_RIGHT
+#define KC_LCTL KC_LEFT_CTRL
+#define KC_LSFT KC_LEFT_SHIFT
+#define KC_LALT KC_LEFT_ALT
+#define KC_LGUI KC_LEFT_GUI
+#define KC_RCTL KC_RIGHT_CTRL
+#define KC_RSFT KC_RIGHT_SHIFT
+#define KC_RALT KC_RIGHT_ALT
+#define KC_RGUI KC_RIGHT_GUI
+
+#define IS_BASIC_KEYCODE(code) ((code) >= KC_A && (code) <= KC_EXSEL)
+#define IS_MODIFIER_KEYCODE(code) ((code) >= KC_LEFT_CTRL && (code) <= KC_RIGHT_GUI)
+
+// Modded keycodes
+#define QK_MODS 0x0000
+#define QK_LCTL 0x0100
+#define QK_LSFT 0x0200
+#define QK_LALT 0x0400
+#define QK_LGUI 0x0800
+#define QK_RMODS_MIN 0x1000
+#define QK_RCTL 0x1100
+#define QK_RSFT 0x1200
+#define QK_RALT 0x1400
+#define QK_RGUI 0x1800
+#define QK_MODS_MAX 0x1FFF
+
+#define LCTL(kc) (QK_LCTL | (kc))
+#define LSFT(kc) (QK_LSFT | (kc))
+#define LALT(kc) (QK_LALT | (kc))
+#define LGUI(kc) (QK_LGUI | (kc))
+#define RCTL(kc) (QK_RCTL | (kc))
+#define RSFT(kc) (QK_RSFT | (kc))
+#define RALT(kc) (QK_RALT | (kc))
+#define RGUI(kc) (QK_RGUI | (kc))
+#define S(kc) LSFT(kc)
+#define A(kc) LALT(kc)
+
+#define IS_QK_MODS(code) ((code) >= QK_MODS && (code) <= QK_MODS_MAX)
+#define QK_MODS_GET_MODS(kc) (((kc) >> 8) & 0x1F)
+#define QK_MODS_GET_BASIC_KEYCODE(kc) ((kc) & 0xFF)
+
+// US ANSI shifted keycodes
+#define KC_TILDE LSFT(KC_GRAVE)
+#define KC_EXCLAIM LSFT(KC_1)
+#define KC_AT LSFT(KC_2)
+#define KC_HASH LSFT(KC_3)
+#define KC_DOLLAR LSFT(KC_4)
+#define KC_PERCENT LSFT(KC_5)
+#define KC_CIRCUMFLEX LSFT(KC_6)
+#define KC_AMPERSAND LSFT(KC_7)
+#define KC_ASTERISK LSFT(KC_8)
+#define KC_LEFT_PAREN LSFT(KC_9)
+#define KC_RIGHT_PAREN LSFT(KC_0)
+#define KC_UNDERSCORE LSFT(KC_MINUS)
+#define KC_PLUS LSFT(KC_EQUAL)
+#define KC_LEFT_CURLY_BRACE LSFT(KC_LEFT_BRACKET)
+#define KC_RIGHT_CURLY_BRACE LSFT(KC_RIGHT_BRACKET)
+#define KC_PIPE LSFT(KC_BACKSLASH)
+#define KC_COLON LSFT(KC_SEMICOLON)
+#define KC_DOUBLE_QUOTE LSFT(KC_QUOTE)
+#define KC_LEFT_ANGLE_BRACKET LSFT(KC_COMMA)
+#define KC_RIGHT_ANGLE_BRACKET LSFT(KC_DOT)
+#define KC_QUESTION LSFT(KC_SLASH)
+#define KC_TILD KC_TILDE
+#define KC_EXLM KC_EXCLAIM
+#define KC_DLR KC_DOLLAR
+#define KC_PERC KC_PERCENT
+#define KC_CIRC KC_CIRCUMFLEX
+#define KC_AMPR KC_AMPERSAND
+#define KC_ASTR KC_ASTERISK
+#define KC_LPRN KC_LEFT_PAREN
+#define KC_RPRN KC_RIGHT_PAREN
+#define KC_UNDS KC_UNDERSCORE
+#define KC_LCBR KC_LEFT_CURLY_BRACE
+#define KC_RCBR KC_RIGHT_CURLY_BRACE
+#define KC_COLN KC_COLON
+#define KC_DQUO KC_DOUBLE_QUOTE
+#define KC_DQT KC_DOUBLE_QUOTE
+#define KC_LABK KC_LEFT_ANGLE_BRACKET
+#define KC_LT KC_LEFT_ANGLE_BRACKET
+#define KC_RABK KC_RIGHT_ANGLE_BRACKET
+#define KC_GT KC_RIGHT_ANGLE_BRACKET
+#define KC_QUES KC_QUESTION
+
+// Modifier bits, in get_mods() format
+#define MOD_LCTL 0x01
+#define MOD_LSFT 0x02
+#define MOD_LALT 0x04
+#define MOD_LGUI 0x08
+#define MOD_RCTL 0x11
+#define MOD_RSFT 0x12
+#define MOD_RALT 0x14
+#define MOD_RGUI 0x18
+
+#define MOD_BIT(code) (1 << ((code) & 0x07))
+#define MOD_BIT_LCTRL MOD_BIT(KC_LEFT_CTRL)
+#define MOD_BIT_LSHIFT MOD_BIT(KC_LEFT_SHIFT)
+#define MOD_BIT_LALT MOD_BIT(KC_LEFT_ALT)
+#define MOD_BIT_LGUI MOD_BIT(KC_LEFT_GUI)
+#define MOD_BIT_RCTRL MOD_BIT(KC_RIGHT_CTRL)
+#define MOD_BIT_RSHIFT MOD_BIT(KC_RIGHT_SHIFT)
+#define MOD_BIT_RALT MOD_BIT(KC_RIGHT_ALT)
+#define MOD_BIT_RGUI MOD_BIT(KC_RIGHT_GUI)
+#define MOD_MASK_CTRL (MOD_BIT_LCTRL | MOD_BIT_RCTRL)
+#define MOD_MASK_SHIFT (MOD_BIT_LSHIFT | MOD_BIT_RSHIFT)
+#define MOD_MASK_ALT (MOD_BIT_LALT | MOD_BIT_RALT)
+#define MOD_MASK_GUI (MOD_BIT_LGUI | MOD_BIT_RGUI)
+#define MOD_MASK_CS (MOD_MASK_CTRL | MOD_MASK_SHIFT)
+#define MOD_MASK_CA (MOD_MASK_CTRL | MOD_MASK_ALT)
+#define MOD_MASK_CG (MOD_MASK_CTRL | MOD_MASK_GUI)
+#define MOD_MASK_SA (MOD_MASK_SHIFT | MOD_MASK_ALT)
+#define MOD_MASK_SG (MOD_MASK_SHIFT | MOD_MASK_GUI)
+#define MOD_MASK_AG (MOD_MASK_ALT | MOD_MASK_GUI)
+#define MOD_MASK_CSA (MOD_MASK_CTRL | MOD_MASK_SHIFT | MOD_MASK_ALT)
+#define MOD_MASK_CSG (MOD_MASK_CTRL | MOD_MASK_SHIFT | MOD_MASK_GUI)
+
+// Quantum keycodes
+#define QK_MOD_TAP 0x2000
+#define QK_MOD_TAP_MAX 0x3FFF
+#define MT(mod, kc) (QK_MOD_TAP | (((mod) & 0x1F) << 8) | ((kc) & 0xFF))
+#define IS_QK_MOD_TAP(code) ((code) >= QK_MOD_TAP && (code) <= QK_MOD_TAP_MAX)
+#define QK_MOD_TAP_GET_MODS(kc) (((kc) >> 8) & 0x1F)
+#define QK_MOD_TAP_GET_TAP_KEYCODE(kc) ((kc) & 0xFF)
+
+#define QK_TO 0x5200
+#define QK_TO_MAX 0x521F
+#define TO(layer) (QK_TO | ((layer) & 0x1F))
+#define IS_QK_TO(code) ((code) >= QK_TO && (code) <= QK_TO_MAX)
+#define QK_TO_GET_LAYER(kc) ((kc) & 0x1F)
+#define MO(layer) (0x5220 | ((layer) & 0x1F))
+#define TG(layer) (0x5260 | ((layer) & 0x1F))
+
+#define QK_ONE_SHOT_MOD 0x52A0
+#define QK_ONE_SHOT_MOD_MAX 0x52BF
+#define OSM(mod) (QK_ONE_SHOT_MOD | ((mod) & 0x1F))
+#define IS_QK_ONE_SHOT_MOD(code) ((code) >= QK_ONE_SHOT_MOD && (code) <= QK_ONE_SHOT_MOD_MAX)
+#define QK_ONE_SHOT_MOD_GET_MODS(kc) ((kc) & 0x1F)
+
+#define QK_REPEAT_KEY 0x7C79
+#define QK_ALT_REPEAT_KEY 0x7C7A
+#define QK_USER 0x7E40
+#define SAFE_RANGE QK_USER
+
+// Key overrides
+typedef enum {
+    ko_option_activation_trigger_down            = (1 << 0),
+    ko_option_activation_required_mod_down       = (1 << 1),
+    ko_option_activation_negative_mod_up         = (1 << 2),
+    ko_option_one_mod                            = (1 << 3),
+    ko_option_no_unregister_on_other_key_down    = (1 << 4),
+    ko_option_no_reregister_trigger              = (1 << 5),
+    ko_options_all_activations                   = ko_option_activation_negative_mod_up | ko_option_activation_required_mod_down | ko_option_activation_trigger_down,
+    ko_options_default                           = ko_options_all_activations,
+} ko_option_t;
+
+typedef struct {
+    uint16_t      trigger;
+    uint8_t       trigger_mods;
+    layer_state_t layers;
+    uint8_t       negative_mod_mask;
+    uint8_t       suppressed_mods;
+    uint16_t      replacement;
+    ko_option_t   options;
+    bool (*custom_action)(bool activated, void *context);
+    void *context;
+    bool *enabled;
+} key_override_t;
+
+#define ko_make_with_layers_negmods_and_options(trigger_mods_, trigger_key, replacement_key, layer_mask, negative_mask, options_) \
+    ((const key_override_t){                                                                                                     \
+        .trigger_mods      = (trigger_mods_),                                                                                    \
+        .layers            = (layer_mask),                                                                                       \
+        .suppressed_mods   = (trigger_mods_),                                                                                    \
+        .options           = (options_),                                                                                         \
+        .negative_mod_mask = (negative_mask),                                                                                    \
+        .custom_action     = NULL,                                                                                               \
+        .context           = NULL,                                                                                               \
+        .trigger           = (trigger_key),                                                                                      \
+        .replacement       = (replacement_key),                                                                                  \
+        .enabled           = NULL,                                                                                               \
+    })
+#define ko_make_with_layers_and_negmods(trigger_mods, trigger_key, replacement_key, layer_mask, negative_mask) ko_make_with_layers_negmods_and_options(trigger_mods, trigger_key, replacement_key, layer_mask, negative_mask, ko_options_default)
+#define ko_make_with_layers(trigger_mods, trigger_key, replacement_key, layer_mask) ko_make_with_layers_and_negmods(trigger_mods, trigger_key, replacement_key, layer_mask, 0)
+bool process_key_override(const uint16_t keycode, const keyrecord_t *const record);
+#define ko_make_basic(trigger_mods, trigger_key, replacement_key) ko_make_with_layers(trigger_mods, trigger_key, replacement_key, ~0)
+
+// Combos
+typedef struct {
+    const uint16_t *keys;
+    uint16_t        keycode;
+    bool            disabled;
+    bool            active;
+    uint16_t        state;
+} combo_t;
+
+#define COMBO_END 0
+#define COMBO(ck, ca) {.keys = &(ck)[0], .keycode = (ca)}
+#ifndef COMBO_TERM
+#    define COMBO_TERM 50
+#endif
+
+#ifndef TAP_CODE_DELAY
+#    define TAP_CODE_DELAY 0
+#endif
+
+// Modifiers
+uint8_t get_mods(void);
+void    add_mods(uint8_t mods);
+void    del_mods(uint8_t mods);
+void    set_mods(uint8_t mods);
+void    clear_mods(void);
+uint8_t get_weak_mods(void);
+void    add_weak_mods(uint8_t mods);
+void    del_weak_mods(uint8_t mods);
+void    set_weak_mods(uint8_t mods);
+uint8_t get_oneshot_mods(void);
+void    add_oneshot_mods(uint8_t mods);
+void    del_oneshot_mods(uint8_t mods);
+void    set_oneshot_mods(uint8_t mods);
+void    clear_oneshot_mods(void);
+void    set_suppressed_override_mods(uint8_t mods);
+void    clear_suppressed_override_mods(void);
+
+// Key codes and reports
+void register_code(uint8_t kc);
+void unregister_code(uint8_t kc);
+void tap_code(uint8_t kc);
+void register_code16(uint16_t kc);
+void unregister_code16(uint16_t kc);
+void tap_code16(uint16_t kc);
+void send_keyboard_report(void);
+
+// Repeat key
+uint16_t get_last_keycode(void);
+uint8_t  get_last_mods(void);
+void     set_last_keycode(uint16_t keycode);
+void     set_last_mods(uint8_t mods);
+int8_t   get_repeat_key_count(void);
+bool     remember_last_key_user(uint16_t keycode, keyrecord_t *record, uint8_t *remembered_mods);
+
+// Layers
+extern layer_state_t layer_state;
+extern layer_state_t default_layer_state;
+uint8_t              get_highest_layer(layer_state_t state);
+void                 layer_move(uint8_t layer);
+
+// Keymap lookup
+uint16_t keycode_at_keymap_location_raw(uint8_t layer_num, uint8_t row, uint8_t column);
+uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column);
+
+// Tap-hold hooks the keymap calls into
+char chordal_hold_handedness(keypos_t key);
+bool is_flow_tap_key(uint16_t keycode);
+
+// Timer
+uint16_t timer_read(void);
+uint32_t timer_read32(void);
+void     wait_ms(uint16_t ms);
+#define TIMER_DIFF_16(a, b) ((uint16_t)((a) - (b)))
+#define timer_elapsed(t) TIMER_DIFF_16(timer_read(), (t))
+#define timer_elapsed32(t) ((uint32_t)(timer_read32() - (t)))
+
+// Console
+int printf(const char *format, ...);
+#define uprintf printf
+#define dprintf(...)
+
+// EEPROM user datablock
+void eeconfig_read_user_datablock(void *data, uint32_t offset, uint32_t length);
+void eeconfig_update_user_datablock(const void *data, uint32_t offset, uint32_t length);
+
+// Underglow
+bool rgblight_is_enabled(void);
+void rgblight_timer_enable(void);
+void rgblight_timer_disable(void);
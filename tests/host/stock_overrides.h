@@ -0,0 +1,83 @@
+// The symbol table as a stock QMK keymap would have it: one flat
+// key_overrides[] list in RAM that the key override engine scans in full on
+// every key press. Blocked keys get an override each, with their own trigger,
+// instead of the shared one process_symbols() handles.
+// Include after keymap_host.h.
+#pragma once
+
+#define STOCK_OVERRIDES_MAX (SYMBOL_ROW_COUNT * SYMBOL_CLASS_COUNT)
+
+static key_override_t stock_overrides[STOCK_OVERRIDES_MAX];
+static uint8_t        stock_override_ids[STOCK_OVERRIDES_MAX]; // symbol_overrides[] index
+static uint16_t       stock_override_count;
+
+// The trigger keycode of each symbol row
+static inline uint16_t symbol_row_trigger(uint8_t row) {
+    for (uint16_t keycode = 0; keycode < ARRAY_SIZE(symbol_rows); keycode++) {
+        if (symbol_rows[keycode] == row) {
+            return keycode;
+        }
+    }
+    for (uint16_t keycode = QK_MODS_MAX + 1; keycode < QK_USER; keycode++) {
+        if (extended_symbol_row(keycode) == row) {
+            return keycode;
+        }
+    }
+    return KC_NO;
+}
+
+// In row order, and in class order within a row, as load_symbol_row() copies them
+static inline void build_stock_overrides(void) {
+    stock_override_count = 0;
+    for (uint8_t row = NO_SYMBOLS + 1; row < SYMBOL_ROW_COUNT; row++) {
+        for (uint8_t class = 0; class < SYMBOL_CLASS_COUNT; class++) {
+            uint8_t override = symbol_table[row][class];
+            if (override == NO_OVERRIDE) {
+                continue;
+            }
+            key_override_t *stock = &stock_overrides[stock_override_count];
+            *stock                = symbol_overrides[override];
+            stock->trigger        = symbol_row_trigger(row);
+
+            stock_override_ids[stock_override_count++] = override;
+        }
+    }
+}
+
+// key_override_count() and key_override_get() as a stock keymap has them, for
+// the host's key override engine
+static inline uint16_t stock_key_override_count(void) {
+    return stock_override_count;
+}
+
+static inline const key_override_t *stock_key_override_get(uint16_t key_override_idx) {
+    return key_override_idx < stock_override_count ? &stock_overrides[key_override_idx] : NULL;
+}
+
+// The stock engine's search on a key press: every override in turn, with the
+// same activation test as symbol_matches() plus the trigger. Returns the
+// symbol_overrides[] index of the first match, or NO_OVERRIDE.
+static inline uint8_t stock_lookup(uint16_t keycode, uint8_t mods, uint8_t layer) {
+    for (uint16_t i = 0; i < stock_override_count; i++) {
+        if (stock_overrides[i].trigger == keycode && symbol_matches(&stock_overrides[i], mods, layer)) {
+            return stock_override_ids[i];
+        }
+    }
+    return NO_OVERRIDE;
+}
+
+// The same search through the dispatch table: the key's row, copied into
+// symbol_cache[] by load_symbol_row(), and the slots in that row
+static inline uint8_t dispatch_lookup(uint16_t keycode, uint8_t mods, uint8_t layer) {
+    uint8_t row = symbol_row_for(keycode);
+    if (row == NO_SYMBOLS) {
+        return NO_OVERRIDE;
+    }
+    load_symbol_row(row);
+    for (uint8_t i = 0; i < symbol_cache_count; i++) {
+        if (symbol_matches(&symbol_cache[symbol_cache_page][i], mods, layer)) {
+            return symbol_cache_ids[symbol_cache_page][i];
+        }
+    }
+    return NO_OVERRIDE;
+}
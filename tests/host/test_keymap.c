@@ -0,0 +1,308 @@
+// Unit tests for keymap.c, run through the host runtime: each test types on
+// the BASE layer and checks the key presses in the reports that come out.
+// Expected symbols are read from the generated tables, so the same tests run
+// against every output profile.
+#include "keymap_host.h"
+#include "stock_overrides.h"
+
+static int failures;
+
+#define CHECK(condition)                                                      \
+    do {                                                                      \
+        if (!(condition)) {                                                   \
+            printf("    %s:%d: %s\n", __FILE__, __LINE__, #condition);         \
+            failures++;                                                       \
+        }                                                                     \
+    } while (0)
+
+// Position of a keycode on a layer (mod-taps by their tap keycode)
+static keypos_t key_of(uint8_t layer, uint16_t keycode) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            uint16_t key = keycode_at_keymap_location(layer, row, col);
+            if (key == keycode || (IS_QK_MOD_TAP(key) && QK_MOD_TAP_GET_TAP_KEYCODE(key) == keycode)) {
+                return (keypos_t){.row = row, .col = col};
+            }
+        }
+    }
+    printf("    no key for 0x%04X on layer %u\n", keycode, layer);
+    failures++;
+    return (keypos_t){.row = 3, .col = 0};
+}
+
+static void press(uint16_t keycode) {
+    keypos_t key = key_of(BASE, keycode);
+    host_key_event(key.row, key.col, true);
+}
+
+static void release(uint16_t keycode) {
+    keypos_t key = key_of(BASE, keycode);
+    host_key_event(key.row, key.col, false);
+}
+
+// A tap that doesn't wait long enough to start a Flow Tap streak or hold
+static void tap(uint16_t keycode) {
+    press(keycode);
+    host_advance(30);
+    release(keycode);
+    host_advance(200);
+}
+
+// The replacement in a symbol row's slot, or KC_NO for an empty slot
+static uint16_t symbol(uint16_t trigger, enum symbol_class class) {
+    uint8_t override = symbol_table[symbol_row_for(trigger)][class];
+    return override == NO_OVERRIDE ? KC_NO : symbol_overrides[override].replacement;
+}
+
+// The first key press typing a symbol sends
+static host_press_t first_press(uint16_t output) {
+#if COMPOSE_SEQUENCE_COUNT > 0
+    if (IS_COMPOSED(output)) {
+        output = compose_sequences[output - QK_USER][0];
+    }
+#endif
+    return (host_press_t){.mods = symbol_mods(output), .key = QK_MODS_GET_BASIC_KEYCODE(output)};
+}
+
+static host_press_t presses[64];
+static uint32_t     press_count;
+
+static void read_presses(void) {
+    press_count = host_presses(presses, ARRAY_SIZE(presses));
+}
+
+static bool pressed_first(host_press_t expected) {
+    return press_count > 0 && presses[0].mods == expected.mods && presses[0].key == expected.key;
+}
+
+static void test_plain_key(void) {
+    tap(KC_Q);
+    read_presses();
+    CHECK(press_count == 1);
+    CHECK(pressed_first((host_press_t){.mods = 0, .key = KC_Q}));
+}
+
+// One-shot Alt, then a key whose symbol the key override engine sends
+static void test_one_shot_alt_symbol(void) {
+    tap(OSM(MOD_LALT));
+    tap(KC_W);
+    read_presses();
+    CHECK(host_override_activations == 1);
+    CHECK(pressed_first(first_press(symbol(KC_W, SYMBOL_ALT))));
+    CHECK(get_oneshot_mods() == 0);
+    CHECK(get_mods() == 0);
+}
+
+// Homerow mod-taps are sent by process_symbols(): Alt+D, with Alt lifted
+static void test_mod_tap_symbol(void) {
+    tap(OSM(MOD_LALT));
+    tap(KC_D);
+    read_presses();
+    CHECK(press_count == 1);
+    CHECK(pressed_first(first_press(symbol(KC_D, SYMBOL_ALT))));
+    CHECK(get_oneshot_mods() == 0);
+}
+
+// A homerow symbol goes out in two reports: the key with its mods, then the release
+static void test_mod_tap_symbol_reports(void) {
+    uint16_t output = symbol(KC_D, SYMBOL_ALT);
+    if (output > QK_MODS_MAX) {
+        return; // Compose sequence
+    }
+    tap(OSM(MOD_LALT));
+    uint32_t before = host_report_total;
+    press(KC_D);
+    host_advance(30);
+    release(KC_D);
+    host_advance(200);
+    CHECK(host_report_total - before == 3); // symbol, its release, the mod-tap release
+}
+
+// Shift alone reaches the Shift slot of '.', through process_symbols() as
+// well as the engine: the row's gate mods include Shift, not only Alt, so
+// Repeat types the symbol again rather than Shift+'.'
+static void test_shift_symbol(void) {
+    CHECK(symbol(KC_DOT, SYMBOL_SHIFT) != KC_NO);
+    tap(OSM(MOD_LSFT));
+    tap(KC_DOT);
+    tap(QK_REPEAT_KEY);
+    read_presses();
+    CHECK(press_count == 2);
+    CHECK(pressed_first(first_press(symbol(KC_DOT, SYMBOL_SHIFT))));
+    CHECK(press_count == 2 && presses[1].mods == presses[0].mods && presses[1].key == presses[0].key);
+    CHECK(get_oneshot_mods() == 0);
+}
+
+// ... with Shift held as well as one-shot
+static void test_held_shift_symbol(void) {
+    press(OSM(MOD_LSFT));
+    host_advance(30);
+    tap(KC_DOT);
+    release(OSM(MOD_LSFT));
+    host_advance(200);
+    tap(QK_REPEAT_KEY);
+    read_presses();
+    CHECK(press_count == 2);
+    CHECK(pressed_first(first_press(symbol(KC_DOT, SYMBOL_SHIFT))));
+    CHECK(press_count == 2 && presses[1].mods == presses[0].mods && presses[1].key == presses[0].key);
+    CHECK(get_mods() == 0 && get_oneshot_mods() == 0);
+}
+
+// An empty key in the Alt ghost layer sends nothing with Alt held
+static void test_blocked_key(void) {
+    tap(OSM(MOD_LALT));
+    tap(KC_G);
+    read_presses();
+    CHECK(press_count == 0);
+}
+
+// Repeat sends what was typed: the symbol, not Alt+key
+static void test_repeat_symbol(void) {
+    tap(OSM(MOD_LALT));
+    tap(KC_D);
+    tap(QK_REPEAT_KEY);
+    read_presses();
+    CHECK(press_count == 2);
+    CHECK(press_count == 2 && presses[1].mods == presses[0].mods && presses[1].key == presses[0].key);
+}
+
+// A mod-tap held while a key on the other hand is tapped is a modifier
+static void test_permissive_hold(void) {
+    press(KC_D);
+    host_advance(50);
+    tap(KC_J);
+    release(KC_D);
+    host_advance(200);
+    read_presses();
+    CHECK(press_count == 1);
+    CHECK(pressed_first((host_press_t){.mods = MOD_BIT_LGUI, .key = KC_J}));
+}
+
+// ... but a key on the same hand makes it a tap (Chordal Hold)
+static void test_chordal_hold(void) {
+    press(KC_D);
+    host_advance(50);
+    tap(KC_W);
+    release(KC_D);
+    host_advance(200);
+    read_presses();
+    CHECK(press_count == 2);
+    CHECK(pressed_first((host_press_t){.mods = 0, .key = KC_D}));
+}
+
+// A mod-tap pressed right after a letter is tapped straight away (Flow Tap)
+static void test_flow_tap(void) {
+    press(KC_Q);
+    host_advance(20);
+    release(KC_Q);
+    host_advance(20);
+    press(KC_J);
+    read_presses();
+    CHECK(press_count == 2);
+    CHECK(press_count == 2 && presses[1].key == KC_J);
+    release(KC_J);
+}
+
+// Held past the tapping term, a mod-tap is a modifier
+static void test_tapping_term(void) {
+    press(KC_F);
+    host_advance(TAPPING_TERM + 10);
+    CHECK(get_mods() == MOD_BIT_LCTRL);
+    release(KC_F);
+    host_advance(10);
+    CHECK(get_mods() == 0);
+}
+
+// Esc, Tab and Backspace on NAV go back to BASE
+static void test_combo(void) {
+    tap(TO(NAV));
+    CHECK(get_highest_layer(layer_state) == NAV);
+    keypos_t keys[] = {key_of(NAV, KC_ESC), key_of(NAV, KC_TAB), key_of(NAV, KC_BSPC)};
+    for (uint8_t i = 0; i < ARRAY_SIZE(keys); i++) {
+        host_key_event(keys[i].row, keys[i].col, true);
+        host_advance(5);
+    }
+    for (uint8_t i = 0; i < ARRAY_SIZE(keys); i++) {
+        host_key_event(keys[i].row, keys[i].col, false);
+    }
+    host_advance(100);
+    read_presses();
+    CHECK(press_count == 0);
+    CHECK(get_highest_layer(layer_state) == BASE);
+}
+
+// The engine is only shown the row of the key being pressed. Slots that
+// process_symbols() handles are disabled in it, including blocked keys, whose
+// override's KC_NO trigger would otherwise activate on modifiers alone.
+static void test_engine_sees_one_row(void) {
+    tap(KC_W);
+    CHECK(active_symbol_row == symbol_row_for(KC_W));
+    for (uint8_t row = NO_SYMBOLS + 1; row < SYMBOL_ROW_COUNT; row++) {
+        load_symbol_row(row);
+        CHECK(key_override_count() <= SYMBOL_CLASS_COUNT);
+        for (uint16_t i = 0; i < key_override_count(); i++) {
+            const key_override_t *override = key_override_get(i);
+            bool                  disabled = override->enabled != NULL && !*override->enabled;
+            CHECK(override->trigger == symbol_row_trigger(row) || (override->trigger == KC_NO && override->replacement == KC_NO));
+            CHECK(disabled == (override->replacement == KC_NO || IS_COMPOSED(override->replacement)));
+        }
+        CHECK(key_override_get(key_override_count()) == NULL);
+    }
+}
+
+// The dispatch table finds the same override as a scan of the flat list, for
+// every trigger, every combination of mods and every layer
+static void test_dispatch_matches_linear_scan(void) {
+    build_stock_overrides();
+    for (uint8_t row = NO_SYMBOLS + 1; row < SYMBOL_ROW_COUNT; row++) {
+        uint16_t trigger = symbol_row_trigger(row);
+        CHECK(trigger != KC_NO);
+        for (uint16_t mods = 0; mods < 256; mods++) {
+            for (uint8_t layer = 0; layer < LAYER_COUNT; layer++) {
+                if (stock_lookup(trigger, mods, layer) != dispatch_lookup(trigger, mods, layer)) {
+                    printf("    0x%04X mods %02X layer %u\n", trigger, mods, layer);
+                    failures++;
+                    return;
+                }
+            }
+        }
+    }
+}
+
+typedef struct {
+    const char *name;
+    void (*run)(void);
+} test_t;
+
+static const test_t tests[] = {
+    {"plain key", test_plain_key},
+    {"one-shot Alt symbol", test_one_shot_alt_symbol},
+    {"mod-tap symbol", test_mod_tap_symbol},
+    {"mod-tap symbol reports", test_mod_tap_symbol_reports},
+    {"Shift symbol", test_shift_symbol},
+    {"held Shift symbol", test_held_shift_symbol},
+    {"blocked key", test_blocked_key},
+    {"repeat symbol", test_repeat_symbol},
+    {"permissive hold", test_permissive_hold},
+    {"chordal hold", test_chordal_hold},
+    {"flow tap", test_flow_tap},
+    {"tapping term", test_tapping_term},
+    {"combo", test_combo},
+    {"engine sees one row", test_engine_sees_one_row},
+    {"dispatch matches linear scan", test_dispatch_matches_linear_scan},
+};
+
+int main(void) {
+    int failed = 0;
+    for (uint8_t i = 0; i < ARRAY_SIZE(tests); i++) {
+        int before = failures;
+        host_reset();
+        tests[i].run();
+        host_release_all();
+        CHECK(get_mods() == 0 && get_weak_mods() == 0);
+        printf("%s %s\n", failures == before ? "ok  " : "FAIL", tests[i].name);
+        failed += failures != before;
+    }
+    printf("%d of %u tests failed (%s)\n", failed, (unsigned)ARRAY_SIZE(tests), KEYMAP_TABLES);
+    return failed != 0;
+}
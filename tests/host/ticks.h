@@ -0,0 +1,19 @@
+// Timer for the benchmarks: TSC cycles on x86, nanoseconds elsewhere
+#pragma once
+
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#    include <x86intrin.h>
+#    define TICKS "TSC cycles"
+static inline uint64_t ticks(void) {
+    return __rdtsc();
+}
+#else
+#    define TICKS "ns"
+static inline uint64_t ticks(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+#endif
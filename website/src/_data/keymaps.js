@@ -1,3 +1,4 @@
+const crypto = require('crypto');
 const fs = require('fs');
 const path = require('path');
 const yaml = require('js-yaml');
@@ -9,6 +10,9 @@ const { discoverKeymaps } = require(discoverPath);
 // Load symbol mapping
 const symbolMapping = require('./symbolMapping.json');
 
+// Parsed keymaps from earlier builds (see loadKeymapData)
+const CACHE_FILE = path.join(__dirname, '../../.cache/keymap-data.json');
+
 // Position-to-coordinate mapping for LAYOUT_split_3x5_2 (Ferris Sweep)
 // Layout is stored as rows: [L L L L L R R R R R] × 3 rows + [thumb thumb thumb thumb]
 // 34 keys total: 3 rows × 10 keys (5L + 5R) + 4 thumb keys (2L + 2R)
@@ -32,7 +36,7 @@ const POSITION_TO_COORDINATE = [
 
 // Layer type classification
 const LAYER_TYPES = {
-  real: ['BASE', 'NAV', 'ALT_NAV', 'SYMBOL', 'SHIFT_SYMBOL'],  // Physical layers accessed via layer-switch keys
+  real: ['BASE', 'NAV', 'SHIFT_NAV', 'ALT_NAV', 'MOUSE', 'SYMBOL', 'SHIFT_SYMBOL'],  // Physical layers accessed via layer-switch keys
   ghost: ['BASE_SHIFT', 'BASE_ALT', 'BASE_SHIFT_ALT']  // Virtual layers accessed via modifiers
 };
 
@@ -163,6 +167,7 @@ function getLayerModifier(layerName) {
   if (layerName === 'BASE_ALT') return 'RTI';     // OSM Alt on right thumb inside
   if (layerName === 'BASE_SHIFT_ALT') return 'LTI+RTI';  // Both modifiers
   if (layerName === 'SHIFT_SYMBOL') return 'LTI';  // Shift on SYMBOL layer
+  if (layerName === 'SHIFT_NAV') return 'LTI';  // Shift on NAV layer
   if (layerName === 'ALT_NAV') return 'RTI';  // Alt on NAV layer
   return null;
 }
@@ -294,6 +299,11 @@ function categorizeLabeledSymbol(label, layerName) {
     return { category: 'commands', priority: 4, description: label };
   }
 
+  // Mouse keys
+  if (/^(Mouse|Wheel) |Click$/.test(label)) {
+    return { category: 'non-printing', priority: 3, description: label };
+  }
+
   // Special words/labels
   if (label === 'Repeat') {
     return { category: 'special', priority: 3, description: 'Repeat last key' };
@@ -473,19 +483,20 @@ function getRealLayer(layerName) {
   }
   if (layerName === 'BASE') return 'Layer 0 (Base)';
   if (layerName === 'NAV') return 'Layer 1 (Nav)';
+  if (layerName === 'SHIFT_NAV') return 'Layer 1 (Nav)';  // Shift on NAV layer
   if (layerName === 'ALT_NAV') return 'Layer 1 (Nav)';  // Alt on NAV layer
-  if (layerName === 'SYMBOL') return 'Layer 2 (Symbol)';
-  if (layerName === 'SHIFT_SYMBOL') return 'Layer 2 (Symbol)';  // Shift on SYMBOL layer
+  if (layerName === 'MOUSE') return 'Layer 2 (Mouse)';
+  if (layerName === 'SYMBOL') return 'Layer 3 (Symbol)';
+  if (layerName === 'SHIFT_SYMBOL') return 'Layer 3 (Symbol)';  // Shift on SYMBOL layer
   return layerName;
 }
 
 /**
  * Build keymap data structure
  */
-function buildKeymapData(keymapInfo) {
+function buildKeymapData(keymapInfo, fileContents) {
   try {
-    // Read and parse layout.yaml
-    const fileContents = fs.readFileSync(keymapInfo.path, 'utf8');
+    // Parse layout.yaml
     const layoutData = yaml.load(fileContents);
 
     // Parse layers
@@ -539,7 +550,8 @@ function buildKeymapData(keymapInfo) {
     const realLayers = [
       { id: 'layer0', name: 'Layer 0 (Base)' },
       { id: 'layer1', name: 'Layer 1 (Nav)' },
-      { id: 'layer2', name: 'Layer 2 (Symbol)' }
+      { id: 'layer2', name: 'Layer 2 (Mouse)' },
+      { id: 'layer3', name: 'Layer 3 (Symbol)' }
     ];
 
     return {
@@ -561,12 +573,81 @@ function buildKeymapData(keymapInfo) {
   }
 }
 
+/**
+ * Hash of the code and data that turn layout.yaml into keymap data
+ * Changing any of them invalidates every cached keymap.
+ */
+function parserVersion() {
+  const hash = crypto.createHash('sha256');
+  for (const file of [__filename, path.join(__dirname, 'symbolMapping.json')]) {
+    hash.update(fs.readFileSync(file));
+  }
+  return hash.digest('hex');
+}
+
+/**
+ * Load the keymaps parsed by earlier builds
+ * Kept in memory between dev server rebuilds, and in CACHE_FILE between runs.
+ */
+let cache = null;
+
+function loadCache() {
+  const version = parserVersion();
+  if (cache && cache.version === version) {
+    return cache;
+  }
+  try {
+    cache = JSON.parse(fs.readFileSync(CACHE_FILE, 'utf8'));
+  } catch (error) {
+    cache = null;
+  }
+  if (!cache || cache.version !== version) {
+    cache = { version, keymaps: {} };
+  }
+  return cache;
+}
+
+function saveCache() {
+  try {
+    fs.mkdirSync(path.dirname(CACHE_FILE), { recursive: true });
+    fs.writeFileSync(CACHE_FILE, JSON.stringify(cache));
+  } catch (error) {
+    console.warn(`[Eleventy Data] Could not save ${CACHE_FILE}: ${error.message}`);
+  }
+}
+
+/**
+ * Keymap data for one keymap, parsing layout.yaml only if it changed
+ * A file whose mtime and size match the cache is not read at all. Otherwise
+ * its content hash decides, so touching or checking out a file without
+ * changing it does not reparse it. Returns the data and whether it was parsed.
+ */
+function loadKeymapData(keymapInfo) {
+  const stat = fs.statSync(keymapInfo.path);
+  const entry = cache.keymaps[keymapInfo.id];
+  if (entry && entry.path === keymapInfo.path && entry.mtimeMs === stat.mtimeMs && entry.size === stat.size) {
+    return { data: entry.data, parsed: false };
+  }
+
+  const fileContents = fs.readFileSync(keymapInfo.path, 'utf8');
+  const hash = crypto.createHash('sha256').update(fileContents).digest('hex');
+  const cached = entry && entry.path === keymapInfo.path && entry.hash === hash;
+  const data = cached ? entry.data : buildKeymapData(keymapInfo, fileContents);
+  if (data) {
+    cache.keymaps[keymapInfo.id] = { path: keymapInfo.path, mtimeMs: stat.mtimeMs, size: stat.size, hash, data };
+  } else {
+    delete cache.keymaps[keymapInfo.id];
+  }
+  return { data, parsed: !cached };
+}
+
 /**
  * Main data export for Eleventy
  */
 module.exports = function() {
   const rootDir = path.join(__dirname, '../../..');
   const keyboardsDir = path.join(rootDir, 'keyboards');
+  const start = process.hrtime.bigint();
 
   console.log('\n[Eleventy Data] Discovering keymaps...');
 
@@ -574,12 +655,24 @@ module.exports = function() {
   const keymapInfos = discoverKeymaps(keyboardsDir);
   console.log(`[Eleventy Data] Found ${keymapInfos.length} keymap(s)`);
 
-  // Build data for each keymap
-  const keymaps = keymapInfos
-    .map(buildKeymapData)
+  // Build data for each keymap, reusing keymaps that have not changed
+  loadCache();
+  const results = keymapInfos.map(loadKeymapData);
+  const keymaps = results
+    .map(result => result.data)
     .filter(km => km !== null);
+  const parsed = results.filter(result => result.parsed).length;
+
+  // Forget keymaps that no longer exist
+  const ids = new Set(keymapInfos.map(info => info.id));
+  const removed = Object.keys(cache.keymaps).filter(id => !ids.has(id));
+  removed.forEach(id => delete cache.keymaps[id]);
+  if (parsed > 0 || removed.length > 0) {
+    saveCache();
+  }
 
-  console.log(`[Eleventy Data] Processed ${keymaps.length} keymap(s)`);
+  const ms = Number(process.hrtime.bigint() - start) / 1e6;
+  console.log(`[Eleventy Data] Processed ${keymaps.length} keymap(s) in ${ms.toFixed(1)}ms (${parsed} parsed, ${results.length - parsed} cached)`);
 
   // Log some stats
   keymaps.forEach(km => {